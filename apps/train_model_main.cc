@@ -1,3 +1,4 @@
+#include "core/price_store.h"
 #include "core/momentum-prediction/momentum_training_data_factory.h"
 #include "core/momentum-prediction/momentum_model.h"
 #include "core/volatility-prediction/volatility_training_data_factory.h"
@@ -9,21 +10,31 @@ using std::vector;
 
 int main() {
     vector<string> file_paths = {"acciona.csv"};
+    // Csv files are parsed once and shared by both prediction pipelines
+    finadvisor::PriceStore price_store;
+    // Later runs load the binary cache written next to each csv file instead of parsing it again
+    price_store.SetUseBinaryCache(true);
+    price_store = price_store.ValidateFiles(file_paths);
+
     // Momentum Prediction
     finadvisor::MomentumTrainingDataFactory momentum_factory;
-    momentum_factory = momentum_factory.ValidateFiles(file_paths);
+    momentum_factory = momentum_factory.LoadPriceStore(price_store);
     finadvisor::MomentumModel momentum_model;
     momentum_model = momentum_model.ValidateFile(momentum_factory.WriteToOutputFile(momentum_factory));
+    // Testing points are monthly proportions, so nearly every one is answered from the inference table
+    momentum_model.BuildInferenceTable(5);
     finadvisor::MomentumClassifier momentum_classifier;
     momentum_classifier.ValidateFile("testmomentumdata.txt");
     momentum_classifier.CalculateValidationAccuracy(momentum_model, 5);
 
     // Volatility Prediction
     finadvisor::VolatilityTrainingDataFactory volatility_factory;
-    volatility_factory = volatility_factory.ValidateFiles(file_paths);
+    volatility_factory = volatility_factory.LoadPriceStore(price_store);
     finadvisor::VolatilityModel volatility_model;
-    volatility_model.ValidateFile(volatility_factory.WriteToOutputFile(volatility_factory));
+    volatility_model = volatility_model.ValidateFile(volatility_factory.WriteToOutputFile(volatility_factory));
+    // Clusters are trained once; every testing point is then classified by its nearest cluster
+    volatility_model.Train(5);
     finadvisor::VolatilityClassifier volatility_classifier;
-    volatility_classifier.ValidateFile("testvolatilitydata.txt");
-    volatility_classifier.CalculateValidationAccuracy(volatility_model, 5);
+    volatility_classifier = volatility_classifier.ValidateFile("testvolatilitydata.txt");
+    volatility_classifier.CalculateValidationAccuracy(volatility_model);
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef AUTOMATED_FINADVISOR_ARRAY_VIEW_H
+#define AUTOMATED_FINADVISOR_ARRAY_VIEW_H
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Read-only view of a contiguous array owned elsewhere, in the manner of std::span. Element access is not bounds
+ * checked, and the view is invalidated when the owning container grows.
+ *
+ * @tparam T type of element
+ */
+template <typename T>
+class ArrayView {
+    public:
+        ArrayView() : data_(nullptr), size_(0) {}
+
+        ArrayView(const T* data, size_t size) : data_(data), size_(size) {}
+
+        ArrayView(const vector<T>& values) : data_(values.data()), size_(values.size()) {}
+
+        const T& operator[](size_t index) const {
+            return data_[index];
+        }
+
+        const T* begin() const {
+            return data_;
+        }
+
+        const T* end() const {
+            return data_ + size_;
+        }
+
+        const T* data() const {
+            return data_;
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+    private:
+        const T* data_;
+        size_t size_;
+};
+
+}
+
+#endif //AUTOMATED_FINADVISOR_ARRAY_VIEW_H
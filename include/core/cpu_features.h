@@ -0,0 +1,45 @@
+#ifndef AUTOMATED_FINADVISOR_CPU_FEATURES_H
+#define AUTOMATED_FINADVISOR_CPU_FEATURES_H
+
+/**
+ * Instruction sets that SIMD kernels may be compiled for. SSE2 is part of every x86-64 processor, so it is used
+ * whenever the target is x86-64. AVX2 kernels are compiled with per-function target attributes, which only GCC and
+ * Clang support, and must only run after the matching Supports function confirms the processor has them.
+ */
+#if defined(__x86_64__) || defined(_M_X64)
+#define FINADVISOR_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(FINADVISOR_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define FINADVISOR_HAS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace finadvisor {
+
+#ifdef FINADVISOR_HAS_AVX2
+/**
+ * Checks once whether the processor running the program supports AVX2.
+ *
+ * @return true if AVX2 kernels may run
+ */
+inline bool SupportsAvx2() {
+    static const bool supports_avx2 = __builtin_cpu_supports("avx2");
+    return supports_avx2;
+}
+
+/**
+ * Checks once whether the processor running the program supports both AVX2 and fused multiply add.
+ *
+ * @return true if AVX2 kernels using fused multiply add may run
+ */
+inline bool SupportsAvx2Fma() {
+    static const bool supports_avx2_fma = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supports_avx2_fma;
+}
+#endif
+
+}
+
+#endif //AUTOMATED_FINADVISOR_CPU_FEATURES_H
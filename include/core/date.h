@@ -1,20 +1,72 @@
 #ifndef AUTOMATED_FINADVISOR_DATE_H
 #define AUTOMATED_FINADVISOR_DATE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 using std::string;
 
+/**
+ * Calendar date packed into a single integer (year << 9 | month << 5 | day), so dates compare in chronological order
+ * as plain integers and copying a date is as cheap as copying an int.
+ */
 class Date {
     public:
         Date(const string& date);
+        /**
+         * Parses date of the form YYYY-MM-DD directly from characters without splitting them into strings.
+         *
+         * @param date first character of date
+         * @param length number of characters in date
+         */
+        Date(const char* date, size_t length);
+        Date(size_t year, size_t month, size_t day);
+        /**
+         * Rebuilds date from the value returned by GetPackedValue.
+         *
+         * @param packed_value packed representation of date
+         * @return date
+         */
+        static Date FromPackedValue(uint32_t packed_value);
         size_t GetMonth() const;
         size_t GetYear() const;
         size_t GetDay() const;
+        uint32_t GetPackedValue() const;
+        /**
+         * Gets key that is equal for dates in the same calendar month and increases by one from each month to the next.
+         *
+         * @return month key
+         */
+        uint32_t GetMonthKey() const;
+        /**
+         * Gets key that is equal for dates in the same calendar quarter and increases by one from each quarter to the
+         * next.
+         *
+         * @return quarter key
+         */
+        uint32_t GetQuarterKey() const;
+        /**
+         * Gets key that is equal for dates in the same Monday to Sunday week and increases by one from each week to
+         * the next.
+         *
+         * @return week key
+         */
+        uint32_t GetWeekKey() const;
+        bool operator==(const Date& date) const;
+        bool operator!=(const Date& date) const;
+        bool operator<(const Date& date) const;
     private:
-        size_t month_;
-        size_t year_;
-        size_t day_;
+        Date() = default;
+        uint32_t packed_value_;
+        const static uint32_t kYearShift_ = 9;
+        const static uint32_t kMonthShift_ = 5;
+        const static uint32_t kMonthMask_ = 0xF;
+        const static uint32_t kDayMask_ = 0x1F;
+        const static size_t kMonthsPerYear_ = 12;
+        const static size_t kMonthsPerQuarter_ = 3;
+        const static size_t kYearsPerEra_ = 400;
+        const static size_t kDaysPerEra_ = 146097;
 };
 
 
@@ -0,0 +1,83 @@
+#ifndef AUTOMATED_FINADVISOR_LABEL_TABLE_H
+#define AUTOMATED_FINADVISOR_LABEL_TABLE_H
+
+#include <string>
+#include "core/momentum-prediction/momentum_calculator.h"
+#include "core/volatility-prediction/volatility_calculator.h"
+
+using std::string;
+
+namespace finadvisor {
+
+/**
+ * Small integer identifier of a momentum trend or volatility type. Points, clusters and predictions carry labels as
+ * identifiers; label strings are only parsed and formatted when reading or writing files and text.
+ */
+typedef unsigned char LabelId;
+
+constexpr const static LabelId kMomentumDirectionCount_ = 3;
+constexpr const static LabelId kMomentumTrendCount_ = 9;
+constexpr const static LabelId kVolatilityCategoryCount_ = 2;
+constexpr const static LabelId kVolatilityTypeCount_ = 6;
+/**
+ * Identifier of no label. Predicted when no point matches, and carried by points generated before any label was read.
+ */
+constexpr const static LabelId kNoLabel_ = 255;
+
+/**
+ * Gets identifier of a momentum trend.
+ *
+ * @param momentum momentum category and direction
+ * @return identifier below kMomentumTrendCount_
+ */
+constexpr LabelId GetMomentumTrendId(const Momentum& momentum) {
+    return static_cast<LabelId>(static_cast<int>(momentum.category) * kMomentumDirectionCount_ +
+                                static_cast<int>(momentum.direction));
+}
+
+/**
+ * Gets identifier of a volatility type.
+ *
+ * @param volatility volatility measure and category
+ * @return identifier below kVolatilityTypeCount_
+ */
+constexpr LabelId GetVolatilityTypeId(const Volatility& volatility) {
+    return static_cast<LabelId>(static_cast<int>(volatility.measure) * kVolatilityCategoryCount_ +
+                                static_cast<int>(volatility.category));
+}
+
+/**
+ * Parses a momentum trend as written by MomentumTrainingDataFactory, such as "Bullish Reversal".
+ *
+ * @param momentum_trend momentum category and direction separated by a space
+ * @return identifier of momentum trend
+ */
+LabelId ParseMomentumTrend(const string& momentum_trend);
+
+/**
+ * Parses a volatility type as written by VolatilityTrainingDataFactory, such as "Low Implied".
+ *
+ * @param volatility_type volatility measure and category separated by a space
+ * @return identifier of volatility type
+ */
+LabelId ParseVolatilityType(const string& volatility_type);
+
+/**
+ * Formats a momentum trend the way MomentumTrainingDataFactory writes it.
+ *
+ * @param trend_id identifier of momentum trend
+ * @return momentum category and direction separated by a space; empty for kNoLabel_
+ */
+string FormatMomentumTrend(LabelId trend_id);
+
+/**
+ * Formats a volatility type the way VolatilityTrainingDataFactory writes it.
+ *
+ * @param type_id identifier of volatility type
+ * @return volatility measure and category separated by a space; empty for kNoLabel_
+ */
+string FormatVolatilityType(LabelId type_id);
+
+}
+
+#endif //AUTOMATED_FINADVISOR_LABEL_TABLE_H
@@ -0,0 +1,89 @@
+#ifndef AUTOMATED_FINADVISOR_MAPPED_CSV_FILE_H
+#define AUTOMATED_FINADVISOR_MAPPED_CSV_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "core/date.h"
+
+using std::string;
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * View of a single comma separated field that points directly into the underlying file buffer.
+ */
+struct CsvField {
+    const char* begin;
+    size_t length;
+};
+
+/**
+ * Tokenized csv line whose fields reference the buffer they were scanned from, so no strings are allocated.
+ */
+class CsvRow {
+    public:
+        /**
+         * Splits the characters between begin and end on commas.
+         *
+         * @param begin first character of line
+         * @param end one past the last character of line (line break excluded)
+         * @return true if line contains at least one field
+         */
+        bool Parse(const char* begin, const char* end);
+        /**
+         * Converts field into a double without copying it onto the heap.
+         *
+         * @param column index of field within row
+         * @return value of field
+         */
+        double GetDouble(size_t column) const;
+        /**
+         * Converts field of the form YYYY-MM-DD into a Date.
+         *
+         * @param column index of field within row
+         * @return date stored in field
+         */
+        Date GetDate(size_t column) const;
+        size_t GetColumnCount() const;
+    private:
+        const static size_t kMaxColumnCount_ = 16;
+        const static size_t kMaxNumberLength_ = 64;
+        CsvField fields_[kMaxColumnCount_];
+        size_t column_count_ = 0;
+};
+
+/**
+ * Read-only view of a csv file that is memory mapped and scanned once in place.
+ */
+class MappedCsvFile {
+    public:
+        /**
+         * Maps file into memory.
+         *
+         * @param file_path path of csv file
+         */
+        explicit MappedCsvFile(const string& file_path);
+        ~MappedCsvFile();
+        MappedCsvFile(const MappedCsvFile&) = delete;
+        MappedCsvFile& operator=(const MappedCsvFile&) = delete;
+        /**
+         * Tokenizes the next non-empty line of the file.
+         *
+         * @param row row that is overwritten with the fields of the next line
+         * @return false once every line has been read
+         */
+        bool NextRow(CsvRow& row);
+        size_t GetFileSize() const;
+    private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+        size_t position_ = 0;
+        // Only used when memory mapping is unavailable and the file is read into a buffer instead
+        vector<char> buffer_;
+};
+
+}
+
+#endif //AUTOMATED_FINADVISOR_MAPPED_CSV_FILE_H
@@ -1,7 +1,9 @@
 #ifndef AUTOMATED_FINADVISOR_MOMENTUM_CALCULATOR_H
 #define AUTOMATED_FINADVISOR_MOMENTUM_CALCULATOR_H
+#include <cstddef>
 #include <vector>
 #include <string>
+#include "core/rolling_window.h"
 
 using std::vector;
 using std::string;
@@ -34,6 +36,14 @@ struct Momentum {
     MomentumDirection direction;
 };
 
+/**
+ * Slope and relative strength index of one window of price differences.
+ */
+struct MomentumStatistics {
+    double linear_regression_slope;
+    double relative_strength_index;
+};
+
 class MomentumCalculator {
     public:
         /**
@@ -57,12 +67,59 @@ class MomentumCalculator {
          * @return momentum struct indicating category and direction.
          */
         Momentum IdentifyMomentum(const vector<double>& price_differences);
+        /**
+         * Categorizes momentum of a window of price differences without copying the window.
+         *
+         * @param price_differences Pointer to first price difference of window.
+         * @param day_count Number of price differences in window.
+         * @return momentum struct indicating category and direction.
+         */
+        Momentum IdentifyMomentum(const double* price_differences, size_t day_count);
+        /**
+         * Categorizes momentum of many windows that are stored back to back.
+         *
+         * @param price_differences Price differences of every window.
+         * @param window_bounds Window i spans price differences window_bounds[i] up to window_bounds[i + 1].
+         * @return momentum of each window, in order of windows
+         */
+        vector<Momentum> IdentifyMomentums(const vector<double>& price_differences, const vector<size_t>& window_bounds);
+        /**
+         * Computes linear regression slope and relative strength index in a single pass without allocating. Day
+         * counts run from 1 to day_count, so their sums are taken in closed form.
+         *
+         * @param price_differences Pointer to first price difference of window.
+         * @param day_count Number of price differences in window.
+         * @return slope of line of best fit and relative strength index
+         */
+        MomentumStatistics ComputeMomentumStatistics(const double* price_differences, size_t day_count);
+        /**
+         * Computes linear regression slope and relative strength index of a rolling window in constant time.
+         *
+         * @param window Trailing window of price differences.
+         * @return slope of line of best fit and relative strength index
+         */
+        MomentumStatistics ComputeMomentumStatistics(const RollingWindow& window);
+        /**
+         * Categorizes momentum based on slope and relative strength index.
+         *
+         * @param statistics Slope and relative strength index of a window.
+         * @return momentum struct indicating category and direction.
+         */
+        Momentum ClassifyMomentum(const MomentumStatistics& statistics);
+        /**
+         * Sums squared deviations of day counts 1 to day_count from their average.
+         *
+         * @param day_count Number of days.
+         * @return denominator of slope of line of best fit
+         */
+        double ComputeDayCountDeviation(size_t day_count);
     private:
         const static int kFullPercentage_ = 100;
 };
 
-const static vector<string> kMomentumCategories_ = {"Bullish", "Bearish", "Reversal"};
-const static vector<string> kMomentumDirections_ = {"Reversal", "Continuation", "None"};
+// Constant expressions, so no copies are constructed at startup in every translation unit
+constexpr const static char* kMomentumCategories_[] = {"Bullish", "Bearish", "Reversal"};
+constexpr const static char* kMomentumDirections_[] = {"Reversal", "Continuation", "None"};
 
 }
 
@@ -32,18 +32,39 @@ class MomentumClassifier {
         MomentumClassifier ValidateFile(const std::string &file_path);
 
         /**
-         * Computes the proportion of momentum testing points predicted correctly by the model.
+         * Computes the proportion of momentum testing points predicted correctly by the model. Testing points are
+         * split into batches scored concurrently against the one shared model.
          *
          * @param model instance of MomentumModel class that stores momentum points for KNN algorithm
          * @param k Number of nearest neighbors; stands for k in KNN algorithm
          * @return fraction of momentum testing points predicted correctly over total momentum testing points
          */
-        double CalculateValidationAccuracy(MomentumModel model, size_t k);
+        double CalculateValidationAccuracy(const MomentumModel& model, size_t k) const;
+        /**
+         * Computes validation accuracy for every k in a range in a single pass. Nearest neighbors of each momentum
+         * testing point are searched once, for maximum_k, and every smaller k is scored from running sums over them.
+         *
+         * @param model instance of MomentumModel class that stores momentum points for KNN algorithm
+         * @param minimum_k smallest number of nearest neighbors
+         * @param maximum_k largest number of nearest neighbors
+         * @return validation accuracy of each k from minimum_k to maximum_k, in order
+         */
+        vector<double> CalculateValidationAccuracyCurve(const MomentumModel& model, size_t minimum_k,
+                                                        size_t maximum_k) const;
+        /**
+         * Sets number of threads used to score momentum testing points.
+         *
+         * @param thread_count number of threads; 0 selects the hardware concurrency
+         */
+        void SetThreadCount(size_t thread_count);
 
         MomentumPoint GetMomentumTestingPoint(size_t vector_index);
 
     private:
         vector<MomentumPoint> momentum_testing_points_;
+        size_t thread_count_ = 0;
+        // Testing points scored by one task; large enough to amortize handing out tasks to threads
+        const static size_t kBatchSize_ = 64;
 
 };
 
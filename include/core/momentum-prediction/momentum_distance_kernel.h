@@ -0,0 +1,56 @@
+#ifndef AUTOMATED_FINADVISOR_MOMENTUM_DISTANCE_KERNEL_H
+#define AUTOMATED_FINADVISOR_MOMENTUM_DISTANCE_KERNEL_H
+
+#include <cstddef>
+#include <vector>
+#include "core/momentum-prediction/momentum_point_index.h"
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Weighted momentum points in structure of arrays form, as read by the brute force distance kernels.
+ */
+struct MomentumPointArrays {
+    const double* x_coordinates;
+    const double* y_coordinates;
+    const double* z_coordinates;
+    const size_t* weights;
+    size_t point_count;
+};
+
+/**
+ * Computes squared distances from a query point to every momentum point. Uses AVX2 with fused multiply-add or SSE2
+ * when the processor supports them, so results may differ from ComputeMomentumDistance squared in the last bit.
+ *
+ * @param points momentum points
+ * @param x_query_coordinate price increase probability of query point
+ * @param y_query_coordinate price decrease probability of query point
+ * @param z_query_coordinate static price probability of query point
+ * @param squared_distances receives one squared distance per momentum point
+ */
+void ComputeSquaredMomentumDistances(const MomentumPointArrays& points, double x_query_coordinate,
+                                     double y_query_coordinate, double z_query_coordinate, double* squared_distances);
+
+/**
+ * Finds the k nearest momentum points of many query points by brute force. Blocks of query points are compared
+ * against blocks of momentum points small enough to stay in cache, ranking by squared distance. Only the points
+ * that squared distances cannot rule out are kept and ranked by exact distance, which matches
+ * MomentumPointIndex::FindNearestNeighbors bit for bit.
+ *
+ * @param points momentum points
+ * @param x_query_coordinates price increase probability of each query point
+ * @param y_query_coordinates price decrease probability of each query point
+ * @param z_query_coordinates static price probability of each query point
+ * @param query_count number of query points
+ * @param k number of neighbors; may not exceed total weight of momentum points
+ * @param neighbors receives, for every query point, neighbors ordered by distance whose weights sum to k
+ */
+void FindNearestNeighborsBatch(const MomentumPointArrays& points, const double* x_query_coordinates,
+                               const double* y_query_coordinates, const double* z_query_coordinates,
+                               size_t query_count, size_t k, vector<vector<MomentumNeighbor>>& neighbors);
+
+}
+
+#endif //AUTOMATED_FINADVISOR_MOMENTUM_DISTANCE_KERNEL_H
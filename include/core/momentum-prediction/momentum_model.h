@@ -1,7 +1,12 @@
 #ifndef AUTOMATED_FINADVISOR_MOMENTUM_MODEL_H
 #define AUTOMATED_FINADVISOR_MOMENTUM_MODEL_H
 #include <fstream>
+#include <unordered_map>
 #include "core/momentum-prediction/momentum_training_data_factory.h"
+#include "core/momentum-prediction/momentum_point_index.h"
+#include "core/momentum-prediction/momentum_distance_kernel.h"
+#include "core/label_table.h"
+#include "core/array_view.h"
 
 using std::istream;
 
@@ -12,9 +17,9 @@ namespace finadvisor {
  */
 struct MomentumPoint {
     /**
-     * Momentum trend consisting of momentum category and momentum direction.
+     * Identifier of momentum trend consisting of momentum category and momentum direction.
      */
-    string momentum_trend;
+    LabelId momentum_trend;
     /**
      * X coordinate of momentum point representing proportion of positive price differences.
      */
@@ -27,10 +32,20 @@ struct MomentumPoint {
      * Z coordinate of momentum point representing proportion of price differences of 0 magnitude.
      */
     double static_price_probability;
+};
+
+/**
+ * Outcome of the KNN algorithm for one query point.
+ */
+struct MomentumPrediction {
     /**
-     * Distance between current momentum point and target momentum point (i.e. member of testing set).
+     * Mean of distance of nearest k momentum points; not a number when k is 0.
      */
-    double distance;
+    double k_nearest_labels_average;
+    /**
+     * Identifier of predicted momentum trend, or kNoLabel_ when no momentum point matches.
+     */
+    LabelId trend_id;
 };
 
 class MomentumModel {
@@ -44,9 +59,13 @@ class MomentumModel {
          */
         friend istream &operator>>(istream &input, MomentumModel& model);
         /**
-         * Sets values of MomentumPoint struct.
+         * Sets values of MomentumPoint struct. The point index is rebuilt by the next query.
          */
         void GenerateMomentumPoint();
+        /**
+         * Builds the spatial index over all momentum points. Invoked once the extraction operator has read a file.
+         */
+        void BuildPointIndex();
         /**
          * Invokes extraction operator.
          *
@@ -55,35 +74,32 @@ class MomentumModel {
          */
         MomentumModel ValidateFile(const string& file_path);
         /**
-         * Gets probability for price increase.
+         * Gets probabilities for price increase of unique momentum points.
          *
-         * @param index Vector index
-         * @return probability for price increase
+         * @return view of x coordinates, indexed like GetPointMultiplicities
          */
-        double GetPriceIncreaseProbability(size_t index);
+        ArrayView<double> GetPriceIncreaseProbabilities() const;
         /**
-         * Gets probability for price decrease.
+         * Gets probabilities for price decrease of unique momentum points.
          *
-         * @param index Vector index
-         * @return probability for price decrease
+         * @return view of y coordinates, indexed like GetPointMultiplicities
          */
-        double GetPriceDecreaseProbability(size_t index);
+        ArrayView<double> GetPriceDecreaseProbabilities() const;
         /**
-         * Gets probability for static prices
+         * Gets probabilities for static prices of unique momentum points.
          *
-         * @param index Vector index
-         * @return probability for static price
+         * @return view of z coordinates, indexed like GetPointMultiplicities
          */
-        double GetStaticPriceProbability(size_t index);
+        ArrayView<double> GetStaticPriceProbabilities() const;
         /**
-         * Gets momentum trend.
+         * Gets momentum trends of unique momentum points.
          *
-         * @param index Vector index
-         * @return momentum trend
+         * @return view of momentum trend identifiers, indexed like GetPointMultiplicities
          */
-        string GetMomentumTrend(size_t index);
+        ArrayView<LabelId> GetMomentumTrends() const;
         /**
-         * Calculates the average of the distances of the nearest k momentum points.
+         * Calculates the average of the distances of the nearest k momentum points. Nearest points and quartile
+         * distances are found through the point index, which leaves the order of momentum points untouched.
          *
          * @param k Number of nearest neighbors; stands for k in KNN algorithm
          * @param x_query_coordinate Price increase probability of query point
@@ -93,6 +109,86 @@ class MomentumModel {
          */
         double ComputeKNearestLabelsAverage(size_t k, double x_query_coordinate, double y_query_coordinate,
                                                        double z_query_coordinate);
+        /**
+         * Read-only counterpart of ComputeKNearestLabelsAverage. Many threads may query one model at once as long as
+         * each passes its own scratch. Momentum points generated since the point index was built are still taken
+         * into account, by selecting the k nearest points and both quartile distances out of all distances.
+         *
+         * @param k Number of nearest neighbors; stands for k in KNN algorithm
+         * @param x_query_coordinate Price increase probability of query point
+         * @param y_query_coordinate Price decrease probability of query point
+         * @param z_query_coordinate Static price probability of query point
+         * @param scratch working memory of the calling thread
+         * @return Mean of distance of nearest k momentum points
+         */
+        double ComputeKNearestLabelsAverage(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                            double z_query_coordinate, MomentumQueryScratch& scratch) const;
+        /**
+         * Calculates ComputeKNearestLabelsAverage for many query points at once. Nearest neighbors of all query points
+         * are found together by the blocked brute force kernel, while quartile distances still come from the point
+         * index. Falls back to one query point at a time if momentum points were generated since the point index was
+         * built.
+         *
+         * @param k Number of nearest neighbors; stands for k in KNN algorithm
+         * @param x_query_coordinates Price increase probability of each query point
+         * @param y_query_coordinates Price decrease probability of each query point
+         * @param z_query_coordinates Static price probability of each query point
+         * @param k_nearest_labels_averages receives mean of distance of nearest k momentum points of each query point
+         */
+        void ComputeKNearestLabelsAverages(size_t k, const vector<double>& x_query_coordinates,
+                                           const vector<double>& y_query_coordinates,
+                                           const vector<double>& z_query_coordinates,
+                                           vector<double>& k_nearest_labels_averages) const;
+        /**
+         * Finds momentum trend of the momentum point whose distance from the query point is closest to a target
+         * distance. Ties go to the nearer momentum point. Safe to call from many threads at once.
+         *
+         * @param target_distance distance to match, usually the result of ComputeKNearestLabelsAverage
+         * @param x_query_coordinate Price increase probability of query point
+         * @param y_query_coordinate Price decrease probability of query point
+         * @param z_query_coordinate Static price probability of query point
+         * @return identifier of momentum trend of matching momentum point
+         */
+        LabelId FindTrendIdAtDistance(double target_distance, double x_query_coordinate, double y_query_coordinate,
+                                      double z_query_coordinate) const;
+        /**
+         * Precomputes the prediction for every query point that a month of at most maximum_day_count trading days can
+         * produce, i.e. every point whose coordinates are day counts divided by the month's day count. Predictions
+         * come from the regular search, so looking one up gives exactly the same result.
+         *
+         * @param k Number of nearest neighbors the table is built for
+         * @param maximum_day_count longest month covered by the table
+         */
+        void BuildInferenceTable(size_t k, size_t maximum_day_count = kMaximumDayCount_);
+        /**
+         * Predicts momentum trend of a query point. Looks the prediction up in the inference table when the table was
+         * built for k and the query point lies on its lattice; otherwise searches the momentum points. Safe to call
+         * from many threads at once.
+         *
+         * @param k Number of nearest neighbors; stands for k in KNN algorithm
+         * @param x_query_coordinate Price increase probability of query point
+         * @param y_query_coordinate Price decrease probability of query point
+         * @param z_query_coordinate Static price probability of query point
+         * @param scratch working memory of the calling thread
+         * @return prediction for query point
+         */
+        MomentumPrediction PredictMomentum(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                           double z_query_coordinate, MomentumQueryScratch& scratch) const;
+        /**
+         * Predicts momentum trend of a query point for every k from 0 to maximum_k with a single neighbor search.
+         * Averages for smaller k are running sums over the nearest neighbors of maximum_k, and equal those of
+         * ComputeKNearestLabelsAverage. Safe to call from many threads at once.
+         *
+         * @param maximum_k largest number of nearest neighbors
+         * @param x_query_coordinate Price increase probability of query point
+         * @param y_query_coordinate Price decrease probability of query point
+         * @param z_query_coordinate Static price probability of query point
+         * @param scratch working memory of the calling thread
+         * @param predictions receives maximum_k + 1 predictions, indexed by k
+         */
+        void PredictMomentumCurve(size_t maximum_k, double x_query_coordinate, double y_query_coordinate,
+                                  double z_query_coordinate, MomentumQueryScratch& scratch,
+                                  vector<MomentumPrediction>& predictions) const;
         /**
          * Computes the distance between current momentum point and query momentum point.
          *
@@ -104,21 +200,94 @@ class MomentumModel {
          */
         double CalculateEuclideanDistance(const MomentumPoint& current_point, double x_query_coordinate,
                                           double y_query_coordinate, double z_query_coordinate) const;
+        void SetFileLine(const string& line);
+        size_t GetMomentumPointCount() const;
         /**
-         * Determines if the distance of the second MomentumPoint exceeds distance of first MomentumPoint.
+         * Gets number of distinct pairs of momentum point and momentum trend. Queries work on these unique points,
+         * each weighted by its multiplicity, and answer exactly as they would over every momentum point.
          *
-         * @param first_point first MomentumPoint struct for comparison
-         * @param second_point second MomentumPoint struct for comparison
-         * @return true if distance of second MomentumPoint is greater than distance of first MomentumPoint
+         * @return number of unique momentum points
          */
-        friend bool CompareDistance(const MomentumPoint& first_point, const MomentumPoint& second_point);
-        void SetFileLine(const string& line);
-        size_t GetMomentumPointCount();
-        double GetDistance(size_t index);
+        size_t GetUniquePointCount() const;
+        /**
+         * Gets number of momentum points identical to each unique momentum point, momentum trend included.
+         *
+         * @return view of multiplicities of unique momentum points
+         */
+        ArrayView<size_t> GetPointMultiplicities() const;
+        /**
+         * Gets unique momentum point of every generated momentum point, in order generated.
+         *
+         * @return view of indices into the unique momentum point views
+         */
+        ArrayView<size_t> GetPointUniqueIndices() const;
     private:
-        vector<MomentumPoint> momentum_training_points_;
+        /**
+         * Coordinates and momentum trend identifying a unique momentum point.
+         */
+        struct MomentumPointKey {
+            double coordinates[3];
+            LabelId momentum_trend;
+            bool operator==(const MomentumPointKey& key) const;
+        };
+
+        struct MomentumPointKeyHash {
+            size_t operator()(const MomentumPointKey& key) const;
+        };
+
+        /**
+         * Rebuilds the point index if momentum points were generated since it was last built.
+         */
+        void UpdatePointIndex();
+        bool IsPointIndexCurrent() const;
+        MomentumPointArrays GetPointArrays() const;
+        /**
+         * Finds the k nearest neighbors of a query point, ordered by distance, along with its quartile distances.
+         *
+         * @param scratch working memory of the calling thread; neighbors receives the k nearest neighbors
+         */
+        void FindNeighborsAndQuartiles(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                       double z_query_coordinate, MomentumQueryScratch& scratch,
+                                       double& upper_quartile_distance, double& lower_quartile_distance) const;
+        double AverageNeighborLabels(size_t k, const vector<MomentumNeighbor>& neighbors,
+                                     double upper_quartile_distance, double lower_quartile_distance) const;
+        size_t FindPointAtDistance(double target_distance, double x_query_coordinate, double y_query_coordinate,
+                                   double z_query_coordinate) const;
+        MomentumPrediction SearchMomentum(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                          double z_query_coordinate, MomentumQueryScratch& scratch) const;
+        /**
+         * Finds the inference table entry of a query point.
+         *
+         * @param x_query_coordinate Price increase probability of query point
+         * @param y_query_coordinate Price decrease probability of query point
+         * @param z_query_coordinate Static price probability of query point
+         * @param entry receives position of entry in inference table
+         * @return true if query point lies on the lattice of the inference table
+         */
+        bool FindInferenceEntry(double x_query_coordinate, double y_query_coordinate, double z_query_coordinate,
+                                size_t& entry) const;
+
+        // Unique momentum points in order of first appearance, stored as one array per field so distance scans read
+        // only coordinates
+        vector<double> x_coordinates_;
+        vector<double> y_coordinates_;
+        vector<double> z_coordinates_;
+        vector<LabelId> momentum_trends_;
+        vector<size_t> point_multiplicities_;
+        // Unique momentum point of every generated momentum point, in order generated
+        vector<size_t> point_unique_indices_;
+        std::unordered_map<MomentumPointKey, size_t, MomentumPointKeyHash> unique_point_indices_;
+        MomentumPointIndex point_index_;
+        // Predictions for every lattice point, grouped by day count. Within a day count, points are ordered by price
+        // increase count, then by price decrease count.
+        vector<MomentumPrediction> inference_table_;
+        vector<size_t> inference_day_offsets_;
+        size_t inference_k_ = 0;
+        size_t inference_point_count_ = 0;
+        // Longest month of trading days
+        const static size_t kMaximumDayCount_ = 23;
         string file_line_;
-        MomentumPoint current_momentum_point_;
+        MomentumPoint current_momentum_point_ = {kNoLabel_, 0, 0, 0};
         constexpr const static double kThreeQuarters_ = static_cast<double>(3) / 4;
         constexpr const static double kOneQuarters_ = static_cast<double>(1) / 4;
 };
@@ -0,0 +1,205 @@
+#ifndef AUTOMATED_FINADVISOR_MOMENTUM_POINT_INDEX_H
+#define AUTOMATED_FINADVISOR_MOMENTUM_POINT_INDEX_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Computes Euclidean distance between two momentum points from the differences of their coordinates. Shared by
+ * MomentumModel and MomentumPointIndex so both produce bit-identical distances.
+ *
+ * @param x_difference difference of price increase probabilities
+ * @param y_difference difference of price decrease probabilities
+ * @param z_difference difference of static price probabilities
+ * @return distance between the two points
+ */
+inline double ComputeMomentumDistance(double x_difference, double y_difference, double z_difference) {
+    return sqrt(pow(x_difference, 2) + pow(y_difference, 2) + pow(z_difference, 2));
+}
+
+/**
+ * Training point found by a query along with its distance from the query point.
+ */
+struct MomentumNeighbor {
+    /**
+     * Index of training point in the order the points were given to the index.
+     */
+    size_t point_index;
+    double distance;
+    /**
+     * Number of identical training points the neighbor stands for. Nearest neighbor queries count only as many of
+     * them as are needed to make up k.
+     */
+    size_t weight;
+};
+
+/**
+ * Finds the distance that would sit at a given position if every neighbor were repeated as many times as its weight
+ * and then sorted by distance. Uses selection rather than sorting, and reorders the neighbors.
+ *
+ * @param neighbors weighted distances
+ * @param rank position within expanded sorted distances, starting at 0; must be less than the total weight
+ * @return distance at rank
+ */
+double SelectDistanceAtRank(vector<MomentumNeighbor>& neighbors, size_t rank);
+
+/**
+ * Working memory of one nearest neighbor query. Reusing one scratch per thread avoids allocating on every query while
+ * keeping the model and its index read-only.
+ */
+struct MomentumQueryScratch {
+    vector<MomentumNeighbor> neighbors;
+    vector<MomentumNeighbor> candidates;
+};
+
+/**
+ * K-d tree over three dimensional momentum points. Built once, after which every query is read-only, so one index can
+ * serve many threads at once. Every point may carry a weight standing for that many identical points, and every query
+ * answers exactly as it would over the expanded points.
+ */
+class MomentumPointIndex {
+    public:
+        MomentumPointIndex() = default;
+        /**
+         * Builds index over points given coordinate by coordinate.
+         *
+         * @param x_coordinates price increase probability of each point
+         * @param y_coordinates price decrease probability of each point
+         * @param z_coordinates static price probability of each point
+         */
+        MomentumPointIndex(const vector<double>& x_coordinates, const vector<double>& y_coordinates,
+                           const vector<double>& z_coordinates);
+        /**
+         * Builds index over weighted points given coordinate by coordinate.
+         *
+         * @param x_coordinates price increase probability of each point
+         * @param y_coordinates price decrease probability of each point
+         * @param z_coordinates static price probability of each point
+         * @param weights number of identical points each point stands for
+         */
+        MomentumPointIndex(const vector<double>& x_coordinates, const vector<double>& y_coordinates,
+                           const vector<double>& z_coordinates, const vector<size_t>& weights);
+        size_t GetPointCount() const;
+        /**
+         * Gets number of points counting every point as many times as its weight.
+         *
+         * @return sum of weights
+         */
+        size_t GetTotalWeight() const;
+        /**
+         * Finds the k points nearest to the query point.
+         *
+         * @param k number of neighbors; may not exceed total weight
+         * @param x_query_coordinate price increase probability of query point
+         * @param y_query_coordinate price decrease probability of query point
+         * @param z_query_coordinate static price probability of query point
+         * @param neighbors receives neighbors ordered by distance, then by point index, whose weights sum to k
+         */
+        void FindNearestNeighbors(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                  double z_query_coordinate, vector<MomentumNeighbor>& neighbors) const;
+        /**
+         * Finds the distance that would sit at a given position if the distances of every point from the query point
+         * were sorted. Only the points near that distance are visited.
+         *
+         * @param rank position within sorted distances, starting at 0
+         * @param x_query_coordinate price increase probability of query point
+         * @param y_query_coordinate price decrease probability of query point
+         * @param z_query_coordinate static price probability of query point
+         * @return distance at rank
+         */
+        double FindDistanceAtRank(size_t rank, double x_query_coordinate, double y_query_coordinate,
+                                  double z_query_coordinate) const;
+        /**
+         * Finds the distance at a rank, holding candidate distances in scratch memory.
+         *
+         * @param rank position within sorted distances, starting at 0
+         * @param x_query_coordinate price increase probability of query point
+         * @param y_query_coordinate price decrease probability of query point
+         * @param z_query_coordinate static price probability of query point
+         * @param candidates scratch memory for points near the rank
+         * @return distance at rank
+         */
+        double FindDistanceAtRank(size_t rank, double x_query_coordinate, double y_query_coordinate,
+                                  double z_query_coordinate, vector<MomentumNeighbor>& candidates) const;
+        /**
+         * Finds the point whose distance from the query point is closest to a target distance. Ties go to the smaller
+         * distance, then to the smaller point index.
+         *
+         * @param target_distance distance to match
+         * @param x_query_coordinate price increase probability of query point
+         * @param y_query_coordinate price decrease probability of query point
+         * @param z_query_coordinate static price probability of query point
+         * @return closest matching point and its distance
+         */
+        MomentumNeighbor FindClosestDistance(double target_distance, double x_query_coordinate,
+                                             double y_query_coordinate, double z_query_coordinate) const;
+    private:
+        /**
+         * Node of tree covering points begin to end in tree order, along with their bounding box.
+         */
+        struct Node {
+            double minimum[3];
+            double maximum[3];
+            size_t begin;
+            size_t end;
+            size_t weight;
+            size_t left;
+            size_t right;
+        };
+
+        /**
+         * Query point along with the distance bounds of nodes.
+         */
+        struct Query {
+            double coordinates[3];
+            double GetMinimumDistance(const Node& node) const;
+            double GetMaximumDistance(const Node& node) const;
+        };
+
+        size_t BuildNode(vector<size_t>& point_indices, size_t begin, size_t end,
+                         const vector<double>* coordinates[3], const vector<size_t>& weights);
+        double GetDistance(const Query& query, size_t position) const;
+        void SearchNearest(size_t node_index, const Query& query, size_t k, vector<MomentumNeighbor>& neighbors,
+                           size_t& neighbor_weight) const;
+        /**
+         * Counts points within a radius of the query point.
+         *
+         * @param node_index node to count in
+         * @param query query point
+         * @param radius largest distance counted
+         * @param point_count incremented by number of points within radius
+         * @param weight incremented by total weight of points within radius
+         */
+        void CountWithin(size_t node_index, const Query& query, double radius, size_t& point_count,
+                         size_t& weight) const;
+        void CollectBetween(size_t node_index, const Query& query, double lower_radius, double upper_radius,
+                            vector<MomentumNeighbor>& candidates) const;
+        void SearchClosestDistance(size_t node_index, const Query& query, double target_distance,
+                                   MomentumNeighbor& closest, double& closest_gap) const;
+        /**
+         * Absolute tolerance within which node bounds and computed point distances may disagree due to rounding.
+         */
+        static double GetTolerance(double distance);
+
+        vector<Node> nodes_;
+        // Coordinates and original indices of points, reordered so every node covers a contiguous range
+        vector<double> x_coordinates_;
+        vector<double> y_coordinates_;
+        vector<double> z_coordinates_;
+        vector<size_t> point_indices_;
+        vector<size_t> weights_;
+        const static size_t kLeafSize_ = 8;
+        const static size_t kNoChild_ = static_cast<size_t>(-1);
+        // Rank queries narrow their search radius until at most this many points remain undecided
+        const static size_t kRankCandidateCount_ = 32;
+        const static size_t kMaximumBisectionCount_ = 64;
+};
+
+}
+
+#endif //AUTOMATED_FINADVISOR_MOMENTUM_POINT_INDEX_H
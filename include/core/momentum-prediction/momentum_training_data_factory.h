@@ -3,15 +3,17 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include "core/momentum-prediction/momentum_calculator.h"
+#include "core/mapped_csv_file.h"
+#include "core/month_table.h"
+#include "core/rolling_window.h"
+#include "core/price_store.h"
 
 using std::string;
 using std::wstring;
 using std::vector;
 using std::istream;
 using std::ostream;
-using std::map;
 
 namespace finadvisor {
 
@@ -32,6 +34,38 @@ class MomentumTrainingDataFactory {
          * @return updated instance of MomentumTrainingDataFactory class with member variable values extracted from txt file
          */
         MomentumTrainingDataFactory ValidateFiles(const vector<string>& file_paths) const;
+        /**
+         * Segments already parsed price series into months without touching the csv files again. Series are segmented
+         * in parallel and merged in series order, so the result is identical for any thread count.
+         *
+         * @param store price series shared with the volatility pipeline and visualizers
+         * @return updated instance of MomentumTrainingDataFactory class with member variable values taken from store
+         */
+        MomentumTrainingDataFactory LoadPriceStore(const PriceStore& store) const;
+        /**
+         * Sets number of threads used to parse and segment price series.
+         *
+         * @param thread_count number of threads; 0 selects the hardware concurrency
+         */
+        void SetThreadCount(size_t thread_count);
+        /**
+         * Enables rolling window mode. Besides calendar months, a momentum label is identified for every trading day
+         * over the trailing window of that many days, once a price series has filled the window. Each label is
+         * updated from the previous one in constant time.
+         *
+         * @param window_length number of trading days in window; 0 disables rolling window mode
+         */
+        void SetRollingWindowLength(size_t window_length);
+        size_t GetRollingWindowCount() const;
+        /**
+         * Gets momentum of a rolling window. Windows are ordered by their last trading day within each price series.
+         *
+         * @param window_index index of window
+         * @return momentum identified for window
+         */
+        Momentum GetRollingMomentum(size_t window_index) const;
+        Date GetRollingWindowEndDate(size_t window_index) const;
+        size_t GetMonthCount() const;
         /**
          * Inserts members variables into output txt file representing training data.
          *
@@ -47,13 +81,56 @@ class MomentumTrainingDataFactory {
          * @return file path of output file
          */
         string WriteToOutputFile(MomentumTrainingDataFactory& factory);
-        Momentum GetMomentum(size_t map_index);
-        std::vector<double> GetPriceDifferences(size_t map_index);
+        /**
+         * Gets momentum of a month. Months are ordered chronologically within each price series, and series follow
+         * each other in the order they were read.
+         *
+         * @param month_index index of month
+         * @return momentum identified for month
+         */
+        Momentum GetMomentum(size_t month_index) const;
+        std::vector<double> GetPriceDifferences(size_t month_index) const;
+        /**
+         * Finds a month of a price series.
+         *
+         * @param series_index index of price series in the order the series were read
+         * @param year year of month
+         * @param month month number from 1 to 12
+         * @return index of month for GetMomentum and GetPriceDifferences
+         */
+        size_t FindMonth(size_t series_index, size_t year, size_t month) const;
         static size_t GetClosingPriceIndex();
         static size_t GetOpeningPriceIndex();
     private:
+        /**
+         * Appends price difference of trading day and closes out the current month once a new month begins.
+         *
+         * @param series_index Index of price series the trading day belongs to.
+         * @param date Date of trading day.
+         * @param price_difference Difference between opening and closing price of trading day.
+         */
+        void UpdatePriceDifferences(size_t series_index, const Date& date, double price_difference);
+        /**
+         * Identifies momentum of the current month and stores it.
+         */
+        void InsertCurrentMonth();
+        /**
+         * Appends months of a factory built from the next price series, exactly as if its rows followed the rows
+         * already read.
+         *
+         * @param series_factory factory built from a single price series
+         */
+        void MergeSeries(MomentumTrainingDataFactory& series_factory);
         vector<double> price_differences_;
-        map<vector<double>, Momentum> momentum_by_price_difference_;
+        uint32_t month_key_ = 0;
+        size_t series_index_ = 0;
+        size_t series_count_ = 0;
+        size_t thread_count_ = 0;
+        MonthTable<Momentum> momentum_by_month_;
+        size_t rolling_window_length_ = 0;
+        RollingWindow rolling_window_;
+        vector<Momentum> rolling_momentums_;
+        vector<Date> rolling_window_end_dates_;
         const static size_t kClosingPriceIndex_ = 4;
         const static size_t kOpeningPriceIndex_ = 1;
 };
@@ -0,0 +1,175 @@
+#ifndef AUTOMATED_FINADVISOR_MONTH_TABLE_H
+#define AUTOMATED_FINADVISOR_MONTH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "core/date.h"
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Chronologically ordered table of trading months. Each month stores the daily values it was computed from (e.g. price
+ * differences) and a label (e.g. Momentum). Values of every month are kept back to back in one contiguous vector.
+ * Months are accessed by index in O(1) and looked up by symbol, year and month in O(1).
+ *
+ * @tparam Label type of label computed for each month
+ */
+template <typename Label>
+class MonthTable {
+    public:
+        /**
+         * Appends month to end of table.
+         *
+         * @param symbol_index index of price series the month belongs to
+         * @param month_key month key of month (see Date::GetMonthKey)
+         * @param values daily values of month
+         * @param label label computed from values
+         */
+        void Append(size_t symbol_index, uint32_t month_key, const vector<double>& values, const Label& label) {
+            value_offsets_.emplace_back(values_.size());
+            values_.insert(values_.end(), values.begin(), values.end());
+            labels_.emplace_back(label);
+            month_keys_.emplace_back(month_key);
+            symbol_indices_.emplace_back(symbol_index);
+            IndexMonth(symbol_index, month_key, labels_.size() - 1);
+        }
+
+        /**
+         * Appends every month of another table, keeping their symbol indices.
+         *
+         * @param table table whose months are appended
+         */
+        void AppendTable(const MonthTable<Label>& table) {
+            values_.reserve(values_.size() + table.values_.size());
+            for (size_t month_index = 0; month_index < table.GetMonthCount(); month_index++) {
+                value_offsets_.emplace_back(values_.size());
+                values_.insert(values_.end(), table.GetValuesBegin(month_index), table.GetValuesEnd(month_index));
+                labels_.emplace_back(table.labels_[month_index]);
+                month_keys_.emplace_back(table.month_keys_[month_index]);
+                symbol_indices_.emplace_back(table.symbol_indices_[month_index]);
+                IndexMonth(symbol_indices_.back(), month_keys_.back(), labels_.size() - 1);
+            }
+        }
+
+        size_t GetMonthCount() const {
+            return labels_.size();
+        }
+
+        const Label& GetLabel(size_t month_index) const {
+            CheckMonthIndex(month_index);
+            return labels_[month_index];
+        }
+
+        vector<double> GetValues(size_t month_index) const {
+            CheckMonthIndex(month_index);
+            return vector<double>(GetValuesBegin(month_index), GetValuesEnd(month_index));
+        }
+
+        /**
+         * Gets pointer to first daily value of month without copying the values.
+         *
+         * @param month_index index of month
+         * @return pointer to first value; values of month end at GetValuesEnd
+         */
+        const double* GetValuesBegin(size_t month_index) const {
+            CheckMonthIndex(month_index);
+            return values_.data() + value_offsets_[month_index];
+        }
+
+        const double* GetValuesEnd(size_t month_index) const {
+            CheckMonthIndex(month_index);
+            if (month_index + 1 < value_offsets_.size()) {
+                return values_.data() + value_offsets_[month_index + 1];
+            }
+            return values_.data() + values_.size();
+        }
+
+        uint32_t GetMonthKey(size_t month_index) const {
+            CheckMonthIndex(month_index);
+            return month_keys_[month_index];
+        }
+
+        size_t GetSymbolIndex(size_t month_index) const {
+            CheckMonthIndex(month_index);
+            return symbol_indices_[month_index];
+        }
+
+        /**
+         * Finds month of a symbol.
+         *
+         * @param symbol_index index of price series
+         * @param year year of month
+         * @param month month number from 1 to 12
+         * @return index of month within table
+         */
+        size_t FindMonth(size_t symbol_index, size_t year, size_t month) const {
+            uint32_t month_key = Date(year, month, 1).GetMonthKey();
+            if (symbol_index >= symbol_months_.size() || symbol_months_[symbol_index].month_indices.empty() ||
+                month_key < symbol_months_[symbol_index].first_month_key) {
+                throw std::invalid_argument("Month not found");
+            }
+            const SymbolMonths& symbol_months = symbol_months_[symbol_index];
+            size_t offset = month_key - symbol_months.first_month_key;
+            if (offset >= symbol_months.month_indices.size() || symbol_months.month_indices[offset] == kNoMonth_) {
+                throw std::invalid_argument("Month not found");
+            }
+            return symbol_months.month_indices[offset];
+        }
+
+    private:
+        /**
+         * Months of one symbol, indexed by month key minus the month key of its first month.
+         */
+        struct SymbolMonths {
+            uint32_t first_month_key;
+            vector<size_t> month_indices;
+        };
+
+        void CheckMonthIndex(size_t month_index) const {
+            if (month_index >= labels_.size()) {
+                throw std::invalid_argument("Index out of bounds");
+            }
+        }
+
+        void IndexMonth(size_t symbol_index, uint32_t month_key, size_t month_index) {
+            if (symbol_index >= symbol_months_.size()) {
+                symbol_months_.resize(symbol_index + 1);
+            }
+            SymbolMonths& symbol_months = symbol_months_[symbol_index];
+            if (symbol_months.month_indices.empty()) {
+                symbol_months.first_month_key = month_key;
+            } else if (month_key < symbol_months.first_month_key) {
+                // Only happens for csv files that are not sorted by date
+                symbol_months.month_indices.insert(symbol_months.month_indices.begin(),
+                                                   symbol_months.first_month_key - month_key, kNoMonth_);
+                symbol_months.first_month_key = month_key;
+            }
+            size_t offset = month_key - symbol_months.first_month_key;
+            if (offset >= symbol_months.month_indices.size()) {
+                symbol_months.month_indices.resize(offset + 1, kNoMonth_);
+            }
+            // A month that is split into several entries is found through its first entry
+            if (symbol_months.month_indices[offset] == kNoMonth_) {
+                symbol_months.month_indices[offset] = month_index;
+            }
+        }
+
+        vector<double> values_;
+        vector<size_t> value_offsets_;
+        vector<Label> labels_;
+        vector<uint32_t> month_keys_;
+        vector<size_t> symbol_indices_;
+        vector<SymbolMonths> symbol_months_;
+        const static size_t kNoMonth_ = SIZE_MAX;
+};
+
+template <typename Label>
+const size_t MonthTable<Label>::kNoMonth_;
+
+}
+
+#endif //AUTOMATED_FINADVISOR_MONTH_TABLE_H
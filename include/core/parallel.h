@@ -0,0 +1,29 @@
+#ifndef AUTOMATED_FINADVISOR_PARALLEL_H
+#define AUTOMATED_FINADVISOR_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace finadvisor {
+
+/**
+ * Runs task once for every index in [0, task_count) on a fixed number of worker threads. Indices are handed out
+ * dynamically so uneven tasks (e.g. csv files of different lengths) keep every thread busy. If tasks throw, the
+ * exception of the lowest failing index is rethrown on the calling thread once every worker has finished.
+ *
+ * @param task_count number of tasks
+ * @param thread_count number of worker threads; 0 selects the hardware concurrency
+ * @param task function invoked with the index of each task
+ */
+void ParallelFor(size_t task_count, size_t thread_count, const std::function<void(size_t)>& task);
+
+/**
+ * Gets the number of threads used when no thread count is specified.
+ *
+ * @return number of hardware threads, or 1 if it cannot be determined
+ */
+size_t GetDefaultThreadCount();
+
+}
+
+#endif //AUTOMATED_FINADVISOR_PARALLEL_H
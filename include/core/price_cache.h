@@ -0,0 +1,64 @@
+#ifndef AUTOMATED_FINADVISOR_PRICE_CACHE_H
+#define AUTOMATED_FINADVISOR_PRICE_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include "core/price_store.h"
+
+using std::string;
+
+namespace finadvisor {
+
+/**
+ * Binary sidecar file holding a parsed price series so later runs can skip text parsing of the csv file.
+ *
+ * Layout: header, packed dates, then the opening, high, low, closing and volume columns as raw doubles. The header
+ * records the size and nanosecond modification time of the csv file it was built from along with a hash of the
+ * payload, so a cache that is stale or corrupted is detected and rebuilt.
+ */
+class PriceCache {
+    public:
+        /**
+         * Loads price series from the cache of the csv file if the cache is still valid.
+         *
+         * @param file_path path of csv file (not of cache file)
+         * @param series price series that is overwritten with cached values
+         * @return true if the cache exists and matches the current csv file
+         */
+        static bool Read(const string& file_path, PriceSeries& series);
+        /**
+         * Writes price series to the cache of the csv file. Failure to write is ignored since the cache is optional.
+         *
+         * @param file_path path of csv file (not of cache file)
+         * @param series price series parsed from csv file
+         * @return true if cache file was written
+         */
+        static bool Write(const string& file_path, const PriceSeries& series);
+        /**
+         * Gets path of cache file that sits next to the csv file.
+         *
+         * @param file_path path of csv file
+         * @return path of cache file
+         */
+        static string GetCachePath(const string& file_path);
+    private:
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint64_t source_size;
+            int64_t source_modification_time;
+            uint64_t day_count;
+            uint64_t payload_hash;
+        };
+        constexpr static uint32_t kVersion_ = 2;
+        const static char kExtension_[];
+        const static char kMagic_[4];
+        constexpr static uint64_t kHashOffsetBasis_ = 14695981039346656037ULL;
+        constexpr static uint64_t kHashPrime_ = 1099511628211ULL;
+        static uint64_t HashBytes(const void* bytes, size_t length, uint64_t hash);
+        static uint64_t HashPayload(const vector<uint32_t>& packed_dates, const PriceSeries& series);
+};
+
+}
+
+#endif //AUTOMATED_FINADVISOR_PRICE_CACHE_H
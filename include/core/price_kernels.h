@@ -0,0 +1,43 @@
+#ifndef AUTOMATED_FINADVISOR_PRICE_KERNELS_H
+#define AUTOMATED_FINADVISOR_PRICE_KERNELS_H
+
+#include <cstddef>
+#include <vector>
+#include "core/price_store.h"
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Computes the difference between opening and closing price of every trading day. Uses AVX2 or SSE2 when the
+ * processor supports them and gives results bit-identical to the scalar formula.
+ *
+ * @param opening_prices opening price of each day
+ * @param closing_prices closing price of each day
+ * @param day_count number of days
+ * @param price_differences receives day_count price differences
+ */
+void ComputePriceDifferences(const double* opening_prices, const double* closing_prices, size_t day_count,
+                             double* price_differences);
+
+/**
+ * Computes the quartile price of every trading day exactly as VolatilityCalculator::CalculateQuartilePrice does. Uses
+ * AVX2 or SSE2 when the processor supports them.
+ *
+ * @param opening_prices opening price of each day
+ * @param closing_prices closing price of each day
+ * @param high_prices high price of each day
+ * @param low_prices low price of each day
+ * @param day_count number of days
+ * @param quartile_prices receives day_count quartile prices
+ */
+void ComputeQuartilePrices(const double* opening_prices, const double* closing_prices, const double* high_prices,
+                           const double* low_prices, size_t day_count, double* quartile_prices);
+
+vector<double> ComputePriceDifferences(const PriceSeries& series);
+vector<double> ComputeQuartilePrices(const PriceSeries& series);
+
+}
+
+#endif //AUTOMATED_FINADVISOR_PRICE_KERNELS_H
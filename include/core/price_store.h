@@ -0,0 +1,95 @@
+#ifndef AUTOMATED_FINADVISOR_PRICE_STORE_H
+#define AUTOMATED_FINADVISOR_PRICE_STORE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "core/date.h"
+
+using std::string;
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Daily prices of a single symbol stored column by column so each price type is contiguous in memory.
+ */
+struct PriceSeries {
+    /**
+     * Path of csv file the series was parsed from.
+     */
+    string file_path;
+    vector<Date> dates;
+    vector<double> opening_prices;
+    vector<double> high_prices;
+    vector<double> low_prices;
+    vector<double> closing_prices;
+    vector<double> volumes;
+
+    size_t GetDayCount() const {
+        return dates.size();
+    }
+};
+
+/**
+ * Parses every csv file once and shares the resulting price series between the prediction pipelines and visualizers.
+ */
+class PriceStore {
+    public:
+        /**
+         * Parses csv files into one price series per file. Files are parsed in parallel.
+         *
+         * @param file_paths paths of csv files for extraction purposes
+         * @return instance of PriceStore class containing a price series for each file, in order of file paths
+         */
+        PriceStore ValidateFiles(const vector<string>& file_paths) const;
+        /**
+         * Parses a single csv file into a price series.
+         *
+         * @param file_path path of csv file
+         * @return price series containing every row of file
+         */
+        static PriceSeries ParseSeries(const string& file_path);
+        /**
+         * Parses the csv file. When the binary cache is enabled, loads price series from the cache of the csv file
+         * instead, and rebuilds the cache if it is missing or stale.
+         *
+         * @param file_path path of csv file
+         * @return price series containing every row of file
+         */
+        PriceSeries LoadSeries(const string& file_path) const;
+        /**
+         * Enables or disables the binary cache that sits next to each csv file. Disabled by default, so no files are
+         * written next to the csv files unless asked for.
+         *
+         * @param use_binary_cache true if cache files should be read and written
+         */
+        void SetUseBinaryCache(bool use_binary_cache);
+        /**
+         * Sets number of threads that parse files concurrently.
+         *
+         * @param thread_count number of threads; 0 selects the hardware concurrency
+         */
+        void SetThreadCount(size_t thread_count);
+        size_t GetSeriesCount() const;
+        const PriceSeries& GetSeries(size_t series_index) const;
+        /**
+         * Column indices of csv files.
+         */
+        const static size_t kDateIndex_ = 0;
+        const static size_t kOpeningPriceIndex_ = 1;
+        const static size_t kHighPriceIndex_ = 2;
+        const static size_t kLowPriceIndex_ = 3;
+        const static size_t kClosingPriceIndex_ = 4;
+        const static size_t kVolumeIndex_ = 5;
+    private:
+        vector<PriceSeries> series_;
+        bool use_binary_cache_ = false;
+        size_t thread_count_ = 0;
+        // Used to reserve column capacity up front; each csv line holds roughly this many characters
+        const static size_t kApproximateLineLength_ = 40;
+};
+
+}
+
+#endif //AUTOMATED_FINADVISOR_PRICE_STORE_H
@@ -0,0 +1,93 @@
+#ifndef AUTOMATED_FINADVISOR_ROLLING_WINDOW_H
+#define AUTOMATED_FINADVISOR_ROLLING_WINDOW_H
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Trailing window over the most recent daily values of a series. Every statistic that momentum and volatility are
+ * identified from is updated in constant amortized time as days enter and leave the window. The one exception is a
+ * slope numerator within rounding error of 0, which is recomputed in time linear in the window length because its
+ * sign decides the momentum category; a window of equal values that slides along by that same value is left as it
+ * is, so only series whose slope hovers at 0 without being flat pay the linear cost on every day.
+ */
+class RollingWindow {
+    public:
+        RollingWindow() = default;
+        /**
+         * Creates empty window.
+         *
+         * @param window_length maximum number of days held by window
+         */
+        explicit RollingWindow(size_t window_length);
+        /**
+         * Adds value of the next day and drops the oldest day once the window is full.
+         *
+         * @param value daily value such as a price difference or quartile price
+         */
+        void Add(double value);
+        /**
+         * Removes every day from window.
+         */
+        void Clear();
+        bool IsFull() const;
+        size_t GetWindowLength() const;
+        size_t GetDayCount() const;
+        double GetMean() const;
+        /**
+         * Gets sum of squared deviations of values from their mean.
+         *
+         * @return sum of squared deviations
+         */
+        double GetSquaredDeviationSum() const;
+        /**
+         * Gets numerator of slope of line of best fit with day count 1 to GetDayCount() on x axis.
+         *
+         * @return sum of (day count - average day count) * value
+         */
+        double GetSlopeNumerator() const;
+        double GetTotalGain() const;
+        double GetTotalLoss() const;
+        size_t GetPositiveCount() const;
+        size_t GetNegativeCount() const;
+    private:
+        /**
+         * Recomputes every statistic from the values in window. Run once per window length of added days so rounding
+         * errors of incremental updates cannot build up.
+         */
+        void Synchronize();
+        /**
+         * Recomputes slope numerator from the values in window exactly as MomentumCalculator does.
+         */
+        void SynchronizeSlopeNumerator();
+        void AddStatistics(double value);
+        void RemoveStatistics(double value);
+        vector<double> values_;
+        size_t window_length_ = 0;
+        size_t oldest_position_ = 0;
+        size_t day_count_ = 0;
+        size_t days_since_synchronization_ = 0;
+        // Number of most recent days, up to the window length, whose value equals that of the newest day
+        size_t equal_value_count_ = 0;
+        // Values are shifted by reference_ so sums stay small in magnitude for prices far from 0
+        double reference_ = 0.0;
+        double shifted_sum_ = 0.0;
+        double shifted_absolute_sum_ = 0.0;
+        double mean_ = 0.0;
+        double squared_deviation_sum_ = 0.0;
+        double slope_numerator_ = 0.0;
+        double total_gain_ = 0.0;
+        double total_loss_ = 0.0;
+        size_t positive_count_ = 0;
+        size_t negative_count_ = 0;
+        // Relative size of rounding error that incremental slope numerator updates may build up per squared day
+        constexpr const static double kSlopeRoundingTolerance_ = 1e-13;
+};
+
+}
+
+#endif //AUTOMATED_FINADVISOR_ROLLING_WINDOW_H
@@ -1,8 +1,10 @@
 #ifndef AUTOMATED_FINADVISOR_VOLATILITY_CALCULATOR_H
 #define AUTOMATED_FINADVISOR_VOLATILITY_CALCULATOR_H
 
+#include <cstddef>
 #include <vector>
 #include <string>
+#include "core/rolling_window.h"
 
 using std::vector;
 using std::string;
@@ -34,6 +36,15 @@ struct Volatility {
     VolatilityCategory category;
 };
 
+/**
+ * Variance, beta risk proportion and volatility of one window of quartile prices.
+ */
+struct VolatilityStatistics {
+    double price_variance;
+    double beta_risk_proportion;
+    Volatility volatility;
+};
+
 class VolatilityCalculator {
     public:
         /**
@@ -77,14 +88,63 @@ class VolatilityCalculator {
          * @return Volatility struct indicating category and measure.
          */
         Volatility IdentifyVolatility(const vector<double>& quartile_prices);
+        /**
+         * Categorizes volatility of a rolling window of quartile prices in constant time.
+         *
+         * @param window Trailing window of quartile prices.
+         * @return Volatility struct indicating category and measure.
+         */
+        Volatility IdentifyVolatility(const RollingWindow& window);
+        /**
+         * Computes price variance, beta risk proportion, volatility and Z-scores of a window in a single pass without
+         * allocating. Mean and variance are accumulated with Welford's method, so prices far from 0 do not lose
+         * precision.
+         *
+         * @param quartile_prices Pointer to first quartile price of window.
+         * @param day_count Number of quartile prices in window.
+         * @param standardized_quartile_prices Receives day_count Z-scores; may be null if they are not needed.
+         * @return price variance, beta risk proportion and volatility of window
+         */
+        VolatilityStatistics ComputeVolatilityStatistics(const double* quartile_prices, size_t day_count,
+                                                         double* standardized_quartile_prices) const;
+        /**
+         * Computes statistics of many windows that are stored back to back, such as every month of a symbol.
+         *
+         * @param quartile_prices Quartile prices of every window.
+         * @param window_bounds Window i spans quartile prices window_bounds[i] up to window_bounds[i + 1].
+         * @param standardized_quartile_prices Receives Z-scores at the positions of their quartile prices.
+         * @return statistics of each window, in order of windows
+         */
+        vector<VolatilityStatistics> ComputeVolatilityStatistics(const vector<double>& quartile_prices,
+                                                                 const vector<size_t>& window_bounds,
+                                                                 vector<double>& standardized_quartile_prices) const;
     private:
+        /**
+         * Scales covariance of quartile prices and day counts into beta risk proportion.
+         *
+         * @param linear_regression_slope Slope of line of best fit of quartile prices.
+         * @param price_variance Sum of squared price differences from mean quartile price.
+         * @param day_count Number of trading days.
+         * @return Proportion of price covariance over variance.
+         */
+        double ScaleBetaRiskProportion(double linear_regression_slope, double price_variance, size_t day_count) const;
+        /**
+         * Categorizes volatility based on price variance and beta risk proportion.
+         *
+         * @param price_variance Sum of squared price differences from mean quartile price.
+         * @param beta_risk_proportion Proportion of price covariance over variance.
+         * @param day_count Number of trading days.
+         * @return Volatility struct indicating category and measure.
+         */
+        Volatility ClassifyVolatility(double price_variance, double beta_risk_proportion, size_t day_count) const;
         constexpr const static double kHalfProportion_ = 0.5;
         constexpr const static double kTwoThirdsProportion_ = 2 / static_cast<double>(3);
         constexpr const static double kOneThirdsProportion_ = 1 / static_cast<double>(3);
 };
 
-const static vector<string> kVolatilityMeasures_ = {"High", "Medium", "Low"};
-const static vector<string> kVolatilityCategories_ = {"Implied", "Historical"};
+// Constant expressions, so no copies are constructed at startup in every translation unit
+constexpr const static char* kVolatilityMeasures_[] = {"High", "Medium", "Low"};
+constexpr const static char* kVolatilityCategories_[] = {"Implied", "Historical"};
 
 }
 
@@ -32,17 +32,26 @@ class VolatilityClassifier {
         VolatilityClassifier ValidateFile(const std::string &file_path);
 
         /**
-         * Computes the proportion of volatility testing points predicted correctly by the model.
+         * Computes the proportion of volatility testing points predicted correctly by the model. Testing points are
+         * split into batches classified concurrently against the one trained model.
          *
-         * @param model instance of VolatilityModel class that stores volatility points for k-means clustering algorithm
-         * @param cluster_size number of volatility points in each cluster
+         * @param model instance of VolatilityModel class trained by k-means clustering algorithm
          * @return fraction of volatility testing points predicted correctly over total volatility testing points
          */
-        double CalculateValidationAccuracy(VolatilityModel model, size_t cluster_size);
+        double CalculateValidationAccuracy(const VolatilityModel& model) const;
+        /**
+         * Sets number of threads used to classify volatility testing points.
+         *
+         * @param thread_count number of threads; 0 selects the hardware concurrency
+         */
+        void SetThreadCount(size_t thread_count);
 
         VolatilityPoint GetVolatilityTestingPoint(size_t vector_index);
     private:
         vector<VolatilityPoint> volatility_testing_points_;
+        size_t thread_count_ = 0;
+        // Testing points classified by one task; large enough to amortize handing out tasks to threads
+        const static size_t kBatchSize_ = 256;
 };
 
 }
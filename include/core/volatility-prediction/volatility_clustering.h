@@ -0,0 +1,186 @@
+#ifndef AUTOMATED_FINADVISOR_VOLATILITY_CLUSTERING_H
+#define AUTOMATED_FINADVISOR_VOLATILITY_CLUSTERING_H
+
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "core/volatility-prediction/volatility_model.h"
+
+using std::vector;
+
+namespace finadvisor {
+
+/**
+ * Weighted volatility points in structure of arrays form, as read by the k-means clustering engine.
+ */
+struct VolatilityPointArrays {
+    const double* x_coordinates;
+    const double* y_coordinates;
+    const size_t* weights;
+    size_t point_count;
+};
+
+/**
+ * Training cost of a clustering run.
+ */
+struct ClusteringReport {
+    /**
+     * Number of centroid updates, each followed by reassigning every volatility point.
+     */
+    size_t iteration_count;
+    /**
+     * Sum over volatility points of weight times squared distance to the cluster assigned.
+     */
+    double inertia;
+    /**
+     * Whether the last iteration left every assignment unchanged, rather than the iteration cap stopping the run.
+     */
+    bool converged;
+};
+
+/**
+ * Seeds clusters by k-means++: the first cluster is drawn in proportion to weight, and every further cluster in
+ * proportion to weight times squared distance to the nearest cluster drawn so far. No two clusters share a position,
+ * so fewer than cluster_count clusters are seeded when there are fewer distinct volatility points.
+ *
+ * @param points volatility points
+ * @param cluster_count largest number of clusters
+ * @param generator random number generator owned by the caller, so concurrent callers do not share state
+ * @param clusters receives seeded positions of clusters
+ * @param minimum_distances receives squared distance of each volatility point to its nearest seeded cluster
+ */
+void SeedKMeansPlusPlus(const VolatilityPointArrays& points, size_t cluster_count, std::mt19937_64& generator,
+                        vector<VolatilityPoint>& clusters, vector<double>& minimum_distances);
+
+/**
+ * Assigns every volatility point to its nearest cluster, ties going to the smaller cluster id. Chunks of volatility
+ * points are assigned concurrently.
+ *
+ * @param points volatility points
+ * @param clusters positions of clusters; must not be empty
+ * @param thread_count number of threads; 0 selects the hardware concurrency
+ * @param point_clusters cluster of each volatility point, updated in place
+ * @param minimum_distances receives squared distance of each volatility point to its cluster
+ * @return number of volatility points whose cluster changed
+ */
+size_t AssignNearestClusters(const VolatilityPointArrays& points, const vector<VolatilityPoint>& clusters,
+                             size_t thread_count, vector<size_t>& point_clusters, vector<double>& minimum_distances);
+
+/**
+ * Sums weighted volatility points of each cluster into exactly one centroid per cluster. Every chunk of volatility
+ * points is summed separately and chunk sums are reduced in order, so results do not depend on thread count.
+ *
+ * @param points volatility points
+ * @param point_clusters cluster of each volatility point
+ * @param cluster_count number of clusters
+ * @param thread_count number of threads; 0 selects the hardware concurrency
+ * @param centroids receives cluster_count centroids
+ */
+void SumCentroids(const VolatilityPointArrays& points, const vector<size_t>& point_clusters, size_t cluster_count,
+                  size_t thread_count, vector<Centroid>& centroids);
+
+/**
+ * Moves every cluster to the mean of its centroid. Clusters without volatility points stay where they are.
+ *
+ * @param centroids one centroid per cluster
+ * @param clusters positions of clusters, updated in place
+ */
+void MoveClustersToCentroids(const vector<Centroid>& centroids, vector<VolatilityPoint>& clusters);
+
+/**
+ * Runs Lloyd's k-means algorithm from seeded clusters: volatility points are assigned to their nearest cluster and
+ * clusters moved to the mean of their points until no assignment changes or the iteration cap is reached. Either way
+ * clusters end at the mean of the final assignment and inertia is measured against those positions, though when the
+ * iteration cap stops the run some volatility points may no longer be assigned to their nearest cluster.
+ *
+ * @param points volatility points
+ * @param maximum_iteration_count largest number of centroid updates
+ * @param thread_count number of threads; 0 selects the hardware concurrency
+ * @param clusters seeded positions of clusters, moved in place; must not be empty
+ * @param centroids receives one centroid per cluster, matching the final assignment
+ * @param point_clusters receives cluster of each volatility point
+ * @param minimum_distances receives squared distance of each volatility point to its cluster
+ * @return iterations run and final inertia
+ */
+ClusteringReport RunLloydKMeans(const VolatilityPointArrays& points, size_t maximum_iteration_count,
+                                size_t thread_count, vector<VolatilityPoint>& clusters, vector<Centroid>& centroids,
+                                vector<size_t>& point_clusters, vector<double>& minimum_distances);
+
+/**
+ * Runs Lloyd's k-means algorithm accelerated by Hamerly's distance bounds. Every volatility point keeps an upper
+ * bound on the distance to its cluster and a lower bound on the distance to any other cluster, and is only compared
+ * against every cluster when the bounds cannot prove its cluster unchanged. Produces the same clusters, assignments,
+ * iteration count and inertia as RunLloydKMeans.
+ *
+ * @param points volatility points
+ * @param maximum_iteration_count largest number of centroid updates
+ * @param thread_count number of threads; 0 selects the hardware concurrency
+ * @param clusters seeded positions of clusters, moved in place; must not be empty
+ * @param centroids receives one centroid per cluster, matching the final assignment
+ * @param point_clusters receives cluster of each volatility point
+ * @param minimum_distances receives squared distance of each volatility point to its cluster
+ * @return iterations run and final inertia
+ */
+ClusteringReport RunHamerlyKMeans(const VolatilityPointArrays& points, size_t maximum_iteration_count,
+                                  size_t thread_count, vector<VolatilityPoint>& clusters, vector<Centroid>& centroids,
+                                  vector<size_t>& point_clusters, vector<double>& minimum_distances);
+
+/**
+ * Finds whether every volatility point lies on one line and, if so, the position of each volatility point along it.
+ * Volatility points within a relative distance of 1e-9 of the line, measured against the spread of the points, count
+ * as lying on it.
+ *
+ * @param points volatility points
+ * @param line_coordinates receives position of each volatility point along the line when they are collinear
+ * @return whether volatility points are collinear
+ */
+bool ProjectOntoLine(const VolatilityPointArrays& points, vector<double>& line_coordinates);
+
+/**
+ * Clusters collinear volatility points optimally. Sorted positions along the line are split into contiguous runs by
+ * dynamic programming over weighted prefix sums, minimizing inertia exactly rather than locally. Deterministic, so
+ * no seeding is needed.
+ *
+ * @param points volatility points
+ * @param line_coordinates position of each volatility point along their common line, from ProjectOntoLine
+ * @param cluster_count largest number of clusters; fewer are made when fewer positions differ
+ * @param thread_count number of threads; 0 selects the hardware concurrency
+ * @param clusters receives positions of clusters, ordered along the line
+ * @param centroids receives one centroid per cluster
+ * @param point_clusters receives cluster of each volatility point
+ * @param minimum_distances receives squared distance of each volatility point to its cluster
+ * @return no iterations, converged, and the optimal inertia
+ */
+ClusteringReport RunOptimalOneDimensionalKMeans(const VolatilityPointArrays& points,
+                                                const vector<double>& line_coordinates, size_t cluster_count,
+                                                size_t thread_count, vector<VolatilityPoint>& clusters,
+                                                vector<Centroid>& centroids, vector<size_t>& point_clusters,
+                                                vector<double>& minimum_distances);
+
+/**
+ * Folds a batch of new volatility points into trained clusters by mini-batch k-means. The whole batch is assigned to
+ * the clusters as they stand, then each volatility point is added to the centroid of its cluster and the cluster
+ * moved to the updated mean of that centroid, which keeps every cluster at the mean of all volatility points it has
+ * absorbed. Only per cluster counts and sums are kept, so memory does not grow with the volatility points seen.
+ *
+ * @param batch new volatility points
+ * @param thread_count number of threads; 0 selects the hardware concurrency
+ * @param clusters positions of clusters, moved in place; must not be empty
+ * @param centroids point count and coordinate sums of each cluster, updated in place
+ * @param batch_clusters receives cluster of each volatility point of the batch
+ */
+void FoldMiniBatch(const VolatilityPointArrays& batch, size_t thread_count, vector<VolatilityPoint>& clusters,
+                   vector<Centroid>& centroids, vector<size_t>& batch_clusters);
+
+/**
+ * Computes sum over volatility points of weight times squared distance to the cluster assigned.
+ *
+ * @param points volatility points
+ * @param minimum_distances squared distance of each volatility point to its cluster
+ * @return inertia of clustering
+ */
+double ComputeInertia(const VolatilityPointArrays& points, const vector<double>& minimum_distances);
+
+}
+
+#endif //AUTOMATED_FINADVISOR_VOLATILITY_CLUSTERING_H
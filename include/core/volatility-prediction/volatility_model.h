@@ -6,6 +6,11 @@
 #include <vector>
 #include <fstream>
 #include <cmath>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include "core/label_table.h"
+#include "core/array_view.h"
 
 using std::string;
 using std::vector;
@@ -18,9 +23,9 @@ namespace finadvisor {
  */
 struct VolatilityPoint {
     /**
-     * Volatility type consisting of measure and category.
+     * Identifier of volatility type consisting of measure and category.
      */
-    string volatility_type;
+    LabelId volatility_type;
     /**
      * X coordinate of volatility point representing proportion of positive z-scores.
      */
@@ -29,21 +34,25 @@ struct VolatilityPoint {
      * Y coordinate of volatility point representing proportion of negative z-scores.
      */
     double negative_z_score_probability;
-    /**
-     * Grouping for use in K means clustering algorithm
-     */
-    size_t cluster;
-    /**
-     * Minimum distance between current volatility point and target volatility point.
-     */
-    double minimum_distance;
 
-    double ComputeDistance(const VolatilityPoint& point) {
+    double ComputeDistance(const VolatilityPoint& point) const {
         return pow(point.positive_z_score_probability - positive_z_score_probability, 2) +
             pow(point.negative_z_score_probability - negative_z_score_probability, 2);
     }
 };
 
+struct VolatilityPointArrays;
+
+/**
+ * Enum representing algorithms that train volatility clusters. OneDimensional clusters collinear volatility points
+ * optimally and falls back to Hamerly otherwise.
+ */
+enum class ClusteringMethod {
+    Lloyd = 0,
+    Hamerly = 1,
+    OneDimensional = 2
+};
+
 struct Centroid {
     size_t point_count;
     double x_coordinate_sum;
@@ -78,31 +87,175 @@ class VolatilityModel {
          */
         void SetFileLine(const string& file_line);
         /**
-         * Initializes cluster by assigning volatility points to each one.
+         * Seeds clusters by k-means++ and assigns every volatility point to its nearest cluster.
          *
-         * @param cluster_count number of volatility points in each cluster
+         * @param cluster_count largest number of clusters; fewer are seeded when fewer volatility points differ
          */
         void AssignClusterPoints(size_t cluster_count);
         /**
-         * Updates centroid point counts, x coordinate sums, and y coordinate sums.
+         * Updates centroid point counts, x coordinate sums, and y coordinate sums, one centroid per cluster, and moves
+         * clusters to their centroids.
          */
         void UpdateCentroidData();
+        /**
+         * Clusters volatility points with k-means once and freezes the clusters. Each cluster is labeled with the
+         * volatility type carried by most of its volatility points, so classification only compares against the
+         * frozen clusters.
+         *
+         * @param cluster_count largest number of clusters; fewer are seeded when fewer volatility points differ
+         */
+        void Train(size_t cluster_count);
+        /**
+         * Classifies a volatility point by the nearest trained cluster. Safe to call concurrently once trained.
+         *
+         * @param positive_z_score_probability x coordinate of volatility point
+         * @param negative_z_score_probability y coordinate of volatility point
+         * @return identifier of volatility type of nearest cluster
+         */
+        LabelId ClassifyVolatilityPoint(double positive_z_score_probability,
+                                        double negative_z_score_probability) const;
+        bool IsTrained() const;
+        /**
+         * Folds new volatility points into the trained clusters by mini-batch k-means, without storing them or
+         * revisiting volatility points seen before. Clusters are relabeled with the volatility types they absorb.
+         *
+         * @param volatility_points new volatility points
+         */
+        void FoldVolatilityPoints(const vector<VolatilityPoint>& volatility_points);
+        /**
+         * Sets number of volatility points buffered before they are folded into the trained clusters. Once trained, a
+         * model with a batch size generates volatility points into the buffer instead of storing them, so its memory
+         * stays bounded however many volatility points arrive.
+         *
+         * @param online_batch_size number of volatility points per batch; 0 stores generated volatility points
+         */
+        void SetOnlineBatchSize(size_t online_batch_size);
+        /**
+         * Folds buffered volatility points into the trained clusters without waiting for a full batch.
+         */
+        void FlushVolatilityPoints();
+        size_t GetPendingPointCount() const;
+        /**
+         * Sets largest number of k-means iterations run by Train.
+         *
+         * @param maximum_iteration_count largest number of centroid updates
+         */
+        void SetMaximumIterationCount(size_t maximum_iteration_count);
+        /**
+         * Selects algorithm run by Train. Hamerly's bounds skip most distance computations on large point sets and
+         * train the same clusters as Lloyd's algorithm. OneDimensional, the default, trains deterministic optimal
+         * clusters whenever volatility points lie on one line.
+         *
+         * @param clustering_method clustering algorithm
+         */
+        void SetClusteringMethod(ClusteringMethod clustering_method);
+        /**
+         * Reseeds the random number generator of the model, which draws clusters seeded by k-means++. Models seeded
+         * alike and given the same volatility points train identical clusters.
+         *
+         * @param random_seed seed of random number generator
+         */
+        void SetRandomSeed(uint64_t random_seed);
+        /**
+         * Sets number of threads used to assign volatility points to clusters.
+         *
+         * @param thread_count number of threads; 0 selects the hardware concurrency
+         */
+        void SetThreadCount(size_t thread_count);
+        /**
+         * Gets number of k-means iterations run by the last call to Train.
+         *
+         * @return number of centroid updates
+         */
+        size_t GetIterationCount() const;
+        /**
+         * Gets inertia of the clusters trained by the last call to Train.
+         *
+         * @return sum over volatility points of squared distance to their cluster
+         */
+        double GetInertia() const;
 
-        // Getters
-        string GetVolatilityType(size_t vector_index);
-        double GetPositiveZScoreProbability(size_t vector_index);
-        double GetNegativeZScoreProbability(size_t vector_index);
-        size_t GetClusterCount();
-        VolatilityPoint GetCluster(size_t vector_index);
-        Centroid GetCentroid(size_t vector_index);
-        double GetMinimumDistance(size_t vector_index);
-        size_t GetClusterValue(size_t vector_index);
+        /**
+         * Gets number of distinct pairs of volatility point and volatility type. Clustering works on these unique
+         * points, each weighted by its multiplicity.
+         *
+         * @return number of unique volatility points
+         */
+        size_t GetUniquePointCount() const;
+        size_t GetVolatilityPointCount() const;
+        size_t GetClusterCount() const;
+
+        // Views of unique volatility points, each indexed by unique point; per-point clustering data included
+        ArrayView<double> GetPositiveZScoreProbabilities() const;
+        ArrayView<double> GetNegativeZScoreProbabilities() const;
+        ArrayView<LabelId> GetVolatilityTypes() const;
+        /**
+         * Gets number of volatility points identical to each unique volatility point, volatility type included.
+         *
+         * @return view of multiplicities of unique volatility points
+         */
+        ArrayView<size_t> GetPointMultiplicities() const;
+        ArrayView<size_t> GetPointClusters() const;
+        ArrayView<double> GetMinimumDistances() const;
+        /**
+         * Gets unique volatility point of every generated volatility point, in order generated.
+         *
+         * @return view of indices into the unique volatility point views
+         */
+        ArrayView<size_t> GetPointUniqueIndices() const;
+        ArrayView<VolatilityPoint> GetClusters() const;
+        ArrayView<Centroid> GetCentroids() const;
     private:
-        vector<VolatilityPoint> volatility_points_;
+        /**
+         * Coordinates and volatility type identifying a unique volatility point.
+         */
+        struct VolatilityPointKey {
+            double coordinates[2];
+            LabelId volatility_type;
+            bool operator==(const VolatilityPointKey& key) const;
+        };
+
+        struct VolatilityPointKeyHash {
+            size_t operator()(const VolatilityPointKey& key) const;
+        };
+
+        VolatilityPointArrays GetPointArrays() const;
+        /**
+         * Labels a cluster with the volatility type of most of its volatility points, ties going to the smaller
+         * identifier.
+         */
+        void LabelCluster(size_t cluster_id);
+
+        // Unique volatility points in order of first appearance, stored as one array per field so distance scans read
+        // only coordinates
+        vector<double> positive_z_score_probabilities_;
+        vector<double> negative_z_score_probabilities_;
+        vector<LabelId> volatility_types_;
+        vector<size_t> point_multiplicities_;
+        // Cluster of each unique volatility point and its distance from the nearest cluster
+        vector<size_t> point_clusters_;
+        vector<double> minimum_distances_;
+        // Unique volatility point of every generated volatility point, in order generated
+        vector<size_t> point_unique_indices_;
+        std::unordered_map<VolatilityPointKey, size_t, VolatilityPointKeyHash> unique_point_indices_;
         string file_line_;
-        VolatilityPoint current_volatility_point_;
+        VolatilityPoint current_volatility_point_ = {kNoLabel_, 0, 0};
         vector<Centroid> centroids_;
         vector<VolatilityPoint> clusters_;
+        // Volatility points of each volatility type in each cluster, weighted by multiplicity
+        vector<size_t> cluster_type_counts_;
+        // Generated volatility points waiting to be folded into trained clusters
+        vector<VolatilityPoint> pending_volatility_points_;
+        size_t online_batch_size_ = 0;
+        bool is_trained_ = false;
+        ClusteringMethod clustering_method_ = ClusteringMethod::OneDimensional;
+        size_t maximum_iteration_count_ = kDefaultMaximumIterationCount_;
+        size_t thread_count_ = 0;
+        size_t iteration_count_ = 0;
+        double inertia_ = 0;
+        std::mt19937_64 generator_{kDefaultRandomSeed_};
+        const static size_t kDefaultMaximumIterationCount_ = 100;
+        const static uint64_t kDefaultRandomSeed_ = 5489;
 };
 
 const static string kVolatilityTrainingDataUnicode_ = "0x0000002B,0x0000002D";
@@ -2,16 +2,18 @@
 #define AUTOMATED_FINADVISOR_VOLATILITY_TRAINING_DATA_FACTORY_H
 
 #include "core/volatility-prediction/volatility_calculator.h"
+#include "core/mapped_csv_file.h"
+#include "core/month_table.h"
+#include "core/rolling_window.h"
+#include "core/price_store.h"
 #include <string>
 #include <fstream>
 #include <vector>
-#include <map>
 
 using std::string;
 using std::istream;
 using std::vector;
 using std::ostream;
-using std::map;
 
 struct DailyPrice {
     double opening_price;
@@ -39,6 +41,38 @@ class VolatilityTrainingDataFactory {
          * @return updated instance of VolatilityTrainingDataFactory class with member variable values extracted from txt file
          */
         VolatilityTrainingDataFactory ValidateFiles(const vector<string>& file_paths) const;
+        /**
+         * Segments already parsed price series into months without touching the csv files again. Series are segmented
+         * in parallel and merged in series order, so the result is identical for any thread count.
+         *
+         * @param store price series shared with the momentum pipeline and visualizers
+         * @return updated instance of VolatilityTrainingDataFactory class with member variable values taken from store
+         */
+        VolatilityTrainingDataFactory LoadPriceStore(const PriceStore& store) const;
+        /**
+         * Sets number of threads used to parse and segment price series.
+         *
+         * @param thread_count number of threads; 0 selects the hardware concurrency
+         */
+        void SetThreadCount(size_t thread_count);
+        /**
+         * Enables rolling window mode. Besides calendar months, a volatility label is identified for every trading day
+         * over the trailing window of that many days, once a price series has filled the window. Each label is
+         * updated from the previous one in constant time.
+         *
+         * @param window_length number of trading days in window; 0 disables rolling window mode
+         */
+        void SetRollingWindowLength(size_t window_length);
+        size_t GetRollingWindowCount() const;
+        /**
+         * Gets volatility of a rolling window. Windows are ordered by their last trading day within each price series.
+         *
+         * @param window_index index of window
+         * @return volatility identified for window
+         */
+        Volatility GetRollingVolatility(size_t window_index) const;
+        Date GetRollingWindowEndDate(size_t window_index) const;
+        size_t GetMonthCount() const;
         friend ostream& operator<<(ostream& input, VolatilityTrainingDataFactory& factory);
         /**
          * Creates output file and inserts values that constitute training data set.
@@ -48,17 +82,56 @@ class VolatilityTrainingDataFactory {
          */
         string WriteToOutputFile(VolatilityTrainingDataFactory& factory);
         DailyPrice GetDailyPrice(size_t vector_index);
-        Volatility GetVolatility(size_t map_index);
-        vector<double> GetStandardizedQuartilePrices(size_t map_index);
+        /**
+         * Gets volatility of a month. Months are ordered chronologically within each price series, and series follow
+         * each other in the order they were read.
+         *
+         * @param month_index index of month
+         * @return volatility identified for month
+         */
+        Volatility GetVolatility(size_t month_index) const;
+        vector<double> GetStandardizedQuartilePrices(size_t month_index) const;
+        /**
+         * Finds a month of a price series.
+         *
+         * @param series_index index of price series in the order the series were read
+         * @param year year of month
+         * @param month month number from 1 to 12
+         * @return index of month for GetVolatility and GetStandardizedQuartilePrices
+         */
+        size_t FindMonth(size_t series_index, size_t year, size_t month) const;
     private:
         /**
-         * Adds DailyPrice struct with updated values to daily prices vector.
+         * Adds DailyPrice struct with updated values to daily prices vector and closes out the current month once a
+         * new month begins.
+         *
+         * @param series_index Index of price series the trading day belongs to.
+         * @param date Date of trading day.
+         * @param price Opening, closing, high, and low prices of trading day.
+         * @param quartile_price Quartile price of trading day.
+         */
+        void UpdateDailyPrices(size_t series_index, const Date& date, const DailyPrice& price, double quartile_price);
+        /**
+         * Identifies volatility of the current month and stores it.
+         */
+        void InsertCurrentMonth();
+        /**
+         * Appends months and daily prices of a factory built from the next price series, exactly as if its rows
+         * followed the rows already read.
          *
-         * @param line File line of txt file.
+         * @param series_factory factory built from a single price series
          */
-        void UpdateDailyPrices(const string& line);
+        void MergeSeries(VolatilityTrainingDataFactory& series_factory);
         vector<DailyPrice> daily_prices_;
-        map<vector<double>, Volatility> volatility_by_standardized_quartile_price_;
+        uint32_t month_key_ = 0;
+        size_t series_index_ = 0;
+        size_t series_count_ = 0;
+        size_t thread_count_ = 0;
+        MonthTable<Volatility> volatility_by_month_;
+        size_t rolling_window_length_ = 0;
+        RollingWindow rolling_window_;
+        vector<Volatility> rolling_volatilities_;
+        vector<Date> rolling_window_end_dates_;
         vector<double> quartile_prices_;
         const static size_t kHighPriceIndex_ = 2;
         const static size_t kLowPriceIndex_ = 3;
@@ -2,11 +2,14 @@
 #define FINAL_PROJECT_ANISHMEKA_AUTOMATED_FINADVISOR_APP_H
 
 #include "core/volatility-prediction/volatility_training_data_factory.h"
+#include "core/momentum-prediction/momentum_training_data_factory.h"
+#include "core/price_store.h"
 #include "cinder/app/App.h"
 #include "cinder/app/RendererGl.h"
 #include "cinder/gl/gl.h"
 #include <string>
 #include <vector>
+#include <map>
 #include <filesystem>
 
 using std::string;
@@ -47,6 +50,11 @@ class AutomatedFinadvisorApp : public ci::app::App {
         string price_summary_;
         const static size_t kAverageMonthlyTradingDays_ = 21;
         map<float, DailyPrice> prices_by_chart_location_;
+        vector<string> file_paths_ = {"abengoa.csv"};
+        // Parsed once on startup and shared by both prediction pipelines and the charts
+        PriceStore price_store_;
+        MomentumTrainingDataFactory momentum_factory_;
+        VolatilityTrainingDataFactory volatility_factory_;
 };
 
 }
@@ -3,10 +3,13 @@
 
 #include <vector>
 #include <string>
+#include <map>
 #include "core/volatility-prediction/volatility_training_data_factory.h"
+#include "core/price_store.h"
 
 using std::string;
 using std::vector;
+using std::map;
 
 namespace finadvisor {
 
@@ -17,10 +20,10 @@ class CandlestickChartVisualizer {
         /**
          * Renders candlestick chart on external screen.
          *
-         * @param file_paths paths of data files
+         * @param series price series taken from the shared price store
          * @param month_index index of current month within vector
          */
-        void DrawCandlestickChart(const vector<string> file_paths, size_t month_index) const;
+        void DrawCandlestickChart(const PriceSeries& series, size_t month_index) const;
         /**
          * Renders candlestick wicks on external screen.
          *
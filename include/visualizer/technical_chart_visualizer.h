@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include "core/momentum-prediction/momentum_training_data_factory.h"
 
 using std::string;
 
@@ -31,10 +32,10 @@ class TechnicalChartVisualizer {
         /**
          * Renders technical chart on external screen
          *
-         * @param file_paths Vector containing data paths
+         * @param momentum_factory Factory built once from the shared price store
          * @param month_index Index of current month in vector
          */
-        void DrawTechnicalChart(const vector<string>& file_paths, size_t month_index) const;
+        void DrawTechnicalChart(const MomentumTrainingDataFactory& momentum_factory, size_t month_index) const;
 };
 
 } // visualizer
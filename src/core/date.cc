@@ -1,24 +1,121 @@
 #include "core/date.h"
-#include "core/data_processor.h"
+#include <stdexcept>
 
-using std::stoi;
+using std::invalid_argument;
 
-Date::Date(const string& date) {
-    DataProcessor processor;
-    vector<string> date_components = processor.Split(date, "-");
-    year_ = stoi(date_components[0]);
-    month_ = stoi(date_components[1]);
-    day_ = stoi(date_components[2]);
+namespace {
+
+bool IsDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+size_t ToDigit(char character) {
+    return static_cast<size_t>(character - '0');
+}
+
+}
+
+Date::Date(const string& date) : Date(date.data(), date.size()) {
+}
+
+Date::Date(const char* date, size_t length) {
+    size_t year;
+    size_t month;
+    size_t day;
+    // Fast path for the fixed width YYYY-MM-DD layout used by every csv file
+    if (length == 10 && date[4] == '-' && date[7] == '-' && IsDigit(date[0]) && IsDigit(date[1]) &&
+        IsDigit(date[2]) && IsDigit(date[3]) && IsDigit(date[5]) && IsDigit(date[6]) && IsDigit(date[8]) &&
+        IsDigit(date[9])) {
+        year = ToDigit(date[0]) * 1000 + ToDigit(date[1]) * 100 + ToDigit(date[2]) * 10 + ToDigit(date[3]);
+        month = ToDigit(date[5]) * 10 + ToDigit(date[6]);
+        day = ToDigit(date[8]) * 10 + ToDigit(date[9]);
+    } else {
+        // Components without leading zeros, e.g. 2009-4-1
+        size_t date_components[3] = {0, 0, 0};
+        size_t component_index = 0;
+        bool has_digit = false;
+        for (size_t i = 0; i < length; i++) {
+            if (date[i] == '-') {
+                if (!has_digit || ++component_index == 3) {
+                    throw invalid_argument("Invalid date");
+                }
+                has_digit = false;
+            } else if (IsDigit(date[i])) {
+                date_components[component_index] = date_components[component_index] * 10 + ToDigit(date[i]);
+                has_digit = true;
+            } else {
+                throw invalid_argument("Invalid date");
+            }
+        }
+        if (component_index != 2 || !has_digit) {
+            throw invalid_argument("Invalid date");
+        }
+        year = date_components[0];
+        month = date_components[1];
+        day = date_components[2];
+    }
+    *this = Date(year, month, day);
+}
+
+Date::Date(size_t year, size_t month, size_t day) {
+    if (month < 1 || month > kMonthsPerYear_ || day < 1 || day > kDayMask_ || year > (UINT32_MAX >> kYearShift_)) {
+        throw invalid_argument("Invalid date");
+    }
+    packed_value_ = static_cast<uint32_t>((year << kYearShift_) | (month << kMonthShift_) | day);
+}
+
+Date Date::FromPackedValue(uint32_t packed_value) {
+    Date date;
+    date.packed_value_ = packed_value;
+    return date;
 }
 
 size_t Date::GetDay() const {
-    return day_;
+    return packed_value_ & kDayMask_;
 }
 
 size_t Date::GetMonth() const {
-    return month_;
+    return (packed_value_ >> kMonthShift_) & kMonthMask_;
 }
 
 size_t Date::GetYear() const {
-    return year_;
-}
\ No newline at end of file
+    return packed_value_ >> kYearShift_;
+}
+
+uint32_t Date::GetPackedValue() const {
+    return packed_value_;
+}
+
+uint32_t Date::GetMonthKey() const {
+    return static_cast<uint32_t>(GetYear() * kMonthsPerYear_ + GetMonth() - 1);
+}
+
+uint32_t Date::GetQuarterKey() const {
+    return static_cast<uint32_t>(GetMonthKey() / kMonthsPerQuarter_);
+}
+
+uint32_t Date::GetWeekKey() const {
+    // Day count since -0400-03-01 (days_from_civil by Howard Hinnant, shifted one 400 year era so it never goes
+    // negative), which was a Wednesday
+    size_t year = GetYear() + kYearsPerEra_ - (GetMonth() <= 2 ? 1 : 0);
+    size_t era = year / kYearsPerEra_;
+    size_t year_of_era = year - era * kYearsPerEra_;
+    size_t shifted_month = GetMonth() > 2 ? GetMonth() - 3 : GetMonth() + 9;
+    size_t day_of_year = (153 * shifted_month + 2) / 5 + GetDay() - 1;
+    size_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    size_t day_number = era * kDaysPerEra_ + day_of_era;
+    // Shift by two days so every week starts on a Monday
+    return static_cast<uint32_t>((day_number + 2) / 7);
+}
+
+bool Date::operator==(const Date& date) const {
+    return packed_value_ == date.packed_value_;
+}
+
+bool Date::operator!=(const Date& date) const {
+    return packed_value_ != date.packed_value_;
+}
+
+bool Date::operator<(const Date& date) const {
+    return packed_value_ < date.packed_value_;
+}
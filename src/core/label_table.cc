@@ -0,0 +1,64 @@
+#include "core/label_table.h"
+#include <cstring>
+#include <stdexcept>
+
+using std::invalid_argument;
+
+namespace finadvisor {
+
+namespace {
+
+/**
+ * Checks whether a label is made of two words separated by a space, without building the label from its words.
+ */
+bool MatchesLabel(const string& label, const char* first_word, const char* second_word) {
+    size_t first_length = strlen(first_word);
+    return label.size() == first_length + 1 + strlen(second_word) && label.compare(0, first_length, first_word) == 0 &&
+           label[first_length] == ' ' && label.compare(first_length + 1, string::npos, second_word) == 0;
+}
+
+}
+
+LabelId ParseMomentumTrend(const string& momentum_trend) {
+    for (LabelId trend_id = 0; trend_id < kMomentumTrendCount_; trend_id++) {
+        if (MatchesLabel(momentum_trend, kMomentumCategories_[trend_id / kMomentumDirectionCount_],
+                         kMomentumDirections_[trend_id % kMomentumDirectionCount_])) {
+            return trend_id;
+        }
+    }
+    throw invalid_argument("Unknown label");
+}
+
+LabelId ParseVolatilityType(const string& volatility_type) {
+    for (LabelId type_id = 0; type_id < kVolatilityTypeCount_; type_id++) {
+        if (MatchesLabel(volatility_type, kVolatilityMeasures_[type_id / kVolatilityCategoryCount_],
+                         kVolatilityCategories_[type_id % kVolatilityCategoryCount_])) {
+            return type_id;
+        }
+    }
+    throw invalid_argument("Unknown label");
+}
+
+string FormatMomentumTrend(LabelId trend_id) {
+    if (trend_id == kNoLabel_) {
+        return "";
+    }
+    if (trend_id >= kMomentumTrendCount_) {
+        throw invalid_argument("Index out of bounds");
+    }
+    return string(kMomentumCategories_[trend_id / kMomentumDirectionCount_]) + " " +
+           kMomentumDirections_[trend_id % kMomentumDirectionCount_];
+}
+
+string FormatVolatilityType(LabelId type_id) {
+    if (type_id == kNoLabel_) {
+        return "";
+    }
+    if (type_id >= kVolatilityTypeCount_) {
+        throw invalid_argument("Index out of bounds");
+    }
+    return string(kVolatilityMeasures_[type_id / kVolatilityCategoryCount_]) + " " +
+           kVolatilityCategories_[type_id % kVolatilityCategoryCount_];
+}
+
+}
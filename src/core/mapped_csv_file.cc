@@ -0,0 +1,135 @@
+#include "core/mapped_csv_file.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::invalid_argument;
+
+namespace finadvisor {
+
+bool CsvRow::Parse(const char* begin, const char* end) {
+    if (end > begin && *(end - 1) == '\r') {
+        end--;
+    }
+    column_count_ = 0;
+    if (begin == end) {
+        return false;
+    }
+    const char* field_begin = begin;
+    for (const char* character = begin; character <= end; character++) {
+        if (character == end || *character == ',') {
+            if (column_count_ < kMaxColumnCount_) {
+                fields_[column_count_].begin = field_begin;
+                fields_[column_count_].length = character - field_begin;
+                column_count_++;
+            }
+            field_begin = character + 1;
+        }
+    }
+    return true;
+}
+
+size_t CsvRow::GetColumnCount() const {
+    return column_count_;
+}
+
+double CsvRow::GetDouble(size_t column) const {
+    if (column >= column_count_) {
+        throw invalid_argument("Column index out of bounds");
+    }
+    const CsvField& field = fields_[column];
+    if (field.length == 0 || field.length >= kMaxNumberLength_) {
+        throw invalid_argument("Invalid numeric field");
+    }
+    // strtod requires a terminated string, so the field is copied onto the stack rather than into a std::string
+    char number[kMaxNumberLength_];
+    memcpy(number, field.begin, field.length);
+    number[field.length] = '\0';
+    char* number_end = nullptr;
+    double value = strtod(number, &number_end);
+    if (number_end == number) {
+        throw invalid_argument("Invalid numeric field");
+    }
+    return value;
+}
+
+Date CsvRow::GetDate(size_t column) const {
+    if (column >= column_count_) {
+        throw invalid_argument("Column index out of bounds");
+    }
+    return Date(fields_[column].begin, fields_[column].length);
+}
+
+MappedCsvFile::MappedCsvFile(const string& file_path) {
+#ifdef _WIN32
+    std::ifstream file(file_path, std::ios::binary);
+    if (file.fail() || file.bad()) {
+        throw invalid_argument("Cannot open file");
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else
+    int descriptor = open(file_path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw invalid_argument("Cannot open file");
+    }
+    struct stat file_status;
+    if (fstat(descriptor, &file_status) != 0 || !S_ISREG(file_status.st_mode)) {
+        close(descriptor);
+        throw invalid_argument("Cannot open file");
+    }
+    size_ = static_cast<size_t>(file_status.st_size);
+    if (size_ > 0) {
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close(descriptor);
+            throw invalid_argument("Cannot open file");
+        }
+        // The file is read front to back exactly once
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapping);
+    }
+    // The mapping stays valid after the descriptor is closed
+    close(descriptor);
+#endif
+}
+
+MappedCsvFile::~MappedCsvFile() {
+#ifndef _WIN32
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+size_t MappedCsvFile::GetFileSize() const {
+    return size_;
+}
+
+bool MappedCsvFile::NextRow(CsvRow& row) {
+    while (position_ < size_) {
+        const char* line_begin = data_ + position_;
+        const char* line_end = static_cast<const char*>(memchr(line_begin, '\n', size_ - position_));
+        if (line_end == nullptr) {
+            line_end = data_ + size_;
+        }
+        position_ = (line_end - data_) + 1;
+        if (row.Parse(line_begin, line_end)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -1,85 +1,98 @@
 #include "core/momentum-prediction/momentum_calculator.h"
-#include <numeric>
+#include <stdexcept>
 
-using std::iota;
-using std::accumulate;
 using std::invalid_argument;
-using std::count_if;
-using std::for_each;
 
 namespace finadvisor {
 
-double MomentumCalculator::ComputeLinearRegressionSlope(const vector<double>& price_differences) {
-    vector<size_t> day_counts(price_differences.size());
-    // Populate vector with values from 0 - 99
-    iota(day_counts.begin(), day_counts.end(), 0);
-    // Add 1 to each vector element
-    for_each(day_counts.begin(), day_counts.end(), [](size_t& day_count) { day_count += 1; });
+double MomentumCalculator::ComputeDayCountDeviation(size_t day_count) {
+    double count = static_cast<double>(day_count);
+    // Sum of (day - average day)^2 over days 1 to n is n(n^2 - 1) / 12. For odd n the middle day equals the average,
+    // and that day has always contributed its squared day count instead of 0.
+    double deviation = count * (count * count - 1) / 12;
+    if (day_count % 2 == 1) {
+        double middle_day = (count + 1) / 2;
+        deviation += middle_day * middle_day;
+    }
+    return deviation;
+}
 
-    double day_count_average = accumulate(day_counts.begin(), day_counts.end(), 0.0) / price_differences.size();
-    double price_difference_average = accumulate(price_differences.begin(), price_differences.end(), 0.0) /
-            price_differences.size();
-    double slope_numerator = 0.0;
-    double slope_denominator = 0.0;
+MomentumStatistics MomentumCalculator::ComputeMomentumStatistics(const double* price_differences, size_t day_count) {
+    double slope_denominator = ComputeDayCountDeviation(day_count);
+    if (slope_denominator == 0.0) {
+        throw invalid_argument("Divide by 0 error for denominator of slope of line of best fit");
+    }
 
-    for (size_t i = 0; i < price_differences.size(); i++) {
-        slope_numerator += (day_counts[i] - day_count_average) * (price_differences[i] - price_difference_average);
-        if (day_counts[i] != day_count_average) {
-            slope_denominator += (day_counts[i] - day_count_average) * (day_counts[i] - day_count_average);
-        } else {
-            slope_denominator += pow(day_counts[i], 2);
+    double price_difference_average = 0.0;
+    double slope_numerator = 0.0;
+    double total_gain = 0.0;
+    double total_loss = 0.0;
+    size_t positive_price_count = 0;
+    size_t negative_price_count = 0;
+    for (size_t i = 0; i < day_count; i++) {
+        double price_difference = price_differences[i];
+        // Co-moment of day counts and price differences, both centered on their running averages, so equal price
+        // differences leave the numerator exactly 0. Day i + 1 lies (i + 1) / 2 past the average of the days before.
+        price_difference_average += (price_difference - price_difference_average) / static_cast<double>(i + 1);
+        slope_numerator += (static_cast<double>(i + 1) / 2) * (price_difference - price_difference_average);
+        if (price_difference > 0) {
+            total_gain += price_difference;
+            positive_price_count++;
+        } else if (price_difference < 0) {
+            total_loss += price_difference;
+            negative_price_count++;
         }
     }
 
-    if (slope_denominator == 0.0){
+    // RSI measures the magnitude of recent price changes to evaluate overbought and oversold conditions.
+    // The calculation below makes use of the first step in RSI calculation as the previous average gains and previous
+    // average losses calculations are negligible and taken into account in calculations of current average gains and
+    // losses.
+    double average_gain = total_gain / positive_price_count;
+    double average_loss = total_loss / negative_price_count;
+    MomentumStatistics statistics;
+    statistics.linear_regression_slope = slope_numerator / slope_denominator;
+    statistics.relative_strength_index = kFullPercentage_ - kFullPercentage_ / (1 + (average_gain / average_loss));
+    return statistics;
+}
+
+MomentumStatistics MomentumCalculator::ComputeMomentumStatistics(const RollingWindow& window) {
+    double slope_denominator = ComputeDayCountDeviation(window.GetDayCount());
+    if (slope_denominator == 0.0) {
         throw invalid_argument("Divide by 0 error for denominator of slope of line of best fit");
     }
+    double average_gain = window.GetTotalGain() / window.GetPositiveCount();
+    double average_loss = window.GetTotalLoss() / window.GetNegativeCount();
+    MomentumStatistics statistics;
+    statistics.linear_regression_slope = window.GetSlopeNumerator() / slope_denominator;
+    statistics.relative_strength_index = kFullPercentage_ - kFullPercentage_ / (1 + (average_gain / average_loss));
+    return statistics;
+}
 
-    return slope_numerator / slope_denominator;
+double MomentumCalculator::ComputeLinearRegressionSlope(const vector<double>& price_differences) {
+    return ComputeMomentumStatistics(price_differences.data(), price_differences.size()).linear_regression_slope;
 }
 
-// RSI measures the magnitude of recent price changes to evaluate overbought and oversold conditions.
-// The calculation below makes use of the first step in RSI calculation as the previous average gains and previous
-// average losses calculations are negligible and taken into account in calculations of current average gains and losses.
 double MomentumCalculator::CalculateRelativeStrengthIndex(const vector<double>& price_differences) {
     if (price_differences.empty()) {
         throw std::invalid_argument("Divide by 0 error: Price differences vector is empty");
     }
-    double average_gain = 0.0;
-    double average_loss = 0.0;
-    size_t positive_price_count = 0;
-    size_t negative_price_count = 0;
-    for (double price_difference : price_differences) {
-        if (price_difference > 0) {
-            average_gain += price_difference;
-            positive_price_count++;
-        } else if (price_difference < 0){
-            average_loss += price_difference;
-            negative_price_count++;
-        }
-    }
-    average_gain /= positive_price_count;
-    average_loss /= negative_price_count;
-
-    double lookback_period_percentage = kFullPercentage_ / (1 + (average_gain / average_loss));
-    return kFullPercentage_ - lookback_period_percentage;
+    return ComputeMomentumStatistics(price_differences.data(), price_differences.size()).relative_strength_index;
 }
 
-Momentum MomentumCalculator::IdentifyMomentum(const vector<double> &price_differences) {
+Momentum MomentumCalculator::ClassifyMomentum(const MomentumStatistics& statistics) {
     Momentum momentum;
-    double linear_regression_slope = ComputeLinearRegressionSlope(price_differences);
-    if (linear_regression_slope > 0) {
+    if (statistics.linear_regression_slope > 0) {
         momentum.category = MomentumCategory::Bullish;
-    } else if (linear_regression_slope < 0) {
+    } else if (statistics.linear_regression_slope < 0) {
         momentum.category = MomentumCategory::Bearish;
     } else {
         momentum.category = MomentumCategory::Indecision;
         momentum.direction = MomentumDirection::None;
         return momentum;
     }
-    double relative_strength_index = CalculateRelativeStrengthIndex(price_differences);
-    if ((relative_strength_index > 0 && momentum.category == MomentumCategory::Bullish) ||
-        (relative_strength_index < 0 && momentum.category == MomentumCategory::Bearish)) {
+    if ((statistics.relative_strength_index > 0 && momentum.category == MomentumCategory::Bullish) ||
+        (statistics.relative_strength_index < 0 && momentum.category == MomentumCategory::Bearish)) {
         momentum.direction = MomentumDirection::Continuation;
     } else {
         momentum.direction = MomentumDirection::Reversal;
@@ -87,4 +100,29 @@ Momentum MomentumCalculator::IdentifyMomentum(const vector<double> &price_differ
     return momentum;
 }
 
-}
\ No newline at end of file
+Momentum MomentumCalculator::IdentifyMomentum(const vector<double>& price_differences) {
+    return IdentifyMomentum(price_differences.data(), price_differences.size());
+}
+
+Momentum MomentumCalculator::IdentifyMomentum(const double* price_differences, size_t day_count) {
+    return ClassifyMomentum(ComputeMomentumStatistics(price_differences, day_count));
+}
+
+vector<Momentum> MomentumCalculator::IdentifyMomentums(const vector<double>& price_differences,
+                                                       const vector<size_t>& window_bounds) {
+    vector<Momentum> momentums;
+    if (window_bounds.empty()) {
+        return momentums;
+    }
+    momentums.reserve(window_bounds.size() - 1);
+    for (size_t window = 0; window + 1 < window_bounds.size(); window++) {
+        if (window_bounds[window] > window_bounds[window + 1] || window_bounds[window + 1] > price_differences.size()) {
+            throw invalid_argument("Index out of bounds");
+        }
+        momentums.emplace_back(IdentifyMomentum(price_differences.data() + window_bounds[window],
+                                                window_bounds[window + 1] - window_bounds[window]));
+    }
+    return momentums;
+}
+
+}
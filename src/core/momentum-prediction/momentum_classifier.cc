@@ -1,7 +1,9 @@
 #include "core/momentum-prediction/momentum_classifier.h"
 #include "core/data_processor.h"
-#include <float.h>
+#include "core/parallel.h"
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 using std::ifstream;
 using std::invalid_argument;
@@ -14,7 +16,7 @@ MomentumPoint MomentumClassifier::GetMomentumTestingPoint(size_t vector_index) {
 
 istream& operator>>(istream &input, MomentumClassifier &classifier) {
     DataProcessor processor;
-    MomentumPoint point;
+    MomentumPoint point = {kNoLabel_, 0, 0, 0};
     std::string line;
     while (getline(input, line)) {
         if (!std::isalpha(line[0])) {
@@ -25,7 +27,7 @@ istream& operator>>(istream &input, MomentumClassifier &classifier) {
             classifier.momentum_testing_points_.reserve(classifier.momentum_testing_points_.size() + 1);
             classifier.momentum_testing_points_.emplace_back(point);
         } else {
-            point.momentum_trend = line;
+            point.momentum_trend = ParseMomentumTrend(line);
         }
     }
     return input;
@@ -45,26 +47,64 @@ MomentumClassifier MomentumClassifier::ValidateFile(const string &file_path) {
     }
 }
 
-double MomentumClassifier::CalculateValidationAccuracy(MomentumModel model, size_t k) {
-    double validation_accuracy = 0;
-    for (const MomentumPoint& point : momentum_testing_points_) {
-        double k_nearest_labels_average = model.ComputeKNearestLabelsAverage(k, point.price_increase_probability,
-                                                            point.price_decrease_probability, point.static_price_probability);
-        double min_distance_difference = DBL_MAX;
-        string nearest_label_trend;
-        for (size_t i = 0; i < model.GetMomentumPointCount(); i++) {
-            double distance_difference = abs(model.GetDistance(i) - k_nearest_labels_average);
-            if (distance_difference < min_distance_difference) {
-                min_distance_difference = distance_difference;
-                nearest_label_trend = model.GetMomentumTrend(i);
+double MomentumClassifier::CalculateValidationAccuracy(const MomentumModel& model, size_t k) const {
+    size_t batch_count = (momentum_testing_points_.size() + kBatchSize_ - 1) / kBatchSize_;
+    vector<size_t> correct_counts(batch_count);
+    ParallelFor(batch_count, thread_count_, [&](size_t batch) {
+        MomentumQueryScratch scratch;
+        size_t end = std::min(momentum_testing_points_.size(), (batch + 1) * kBatchSize_);
+        for (size_t i = batch * kBatchSize_; i < end; i++) {
+            const MomentumPoint& point = momentum_testing_points_[i];
+            MomentumPrediction prediction = model.PredictMomentum(k, point.price_increase_probability,
+                                                                  point.price_decrease_probability,
+                                                                  point.static_price_probability, scratch);
+            // Testing points always have a momentum trend, so a prediction of no trend is never correct
+            if (prediction.trend_id == point.momentum_trend) {
+                correct_counts[batch]++;
             }
         }
+    });
 
-        if (nearest_label_trend == point.momentum_trend) {
-            validation_accuracy++;
+    double validation_accuracy = std::accumulate(correct_counts.begin(), correct_counts.end(), size_t(0));
+    return validation_accuracy / momentum_testing_points_.size();
+}
+
+vector<double> MomentumClassifier::CalculateValidationAccuracyCurve(const MomentumModel& model, size_t minimum_k,
+                                                                    size_t maximum_k) const {
+    if (minimum_k > maximum_k) {
+        throw invalid_argument("Index out of bounds");
+    }
+    size_t batch_count = (momentum_testing_points_.size() + kBatchSize_ - 1) / kBatchSize_;
+    vector<vector<size_t>> correct_counts(batch_count, vector<size_t>(maximum_k - minimum_k + 1));
+    ParallelFor(batch_count, thread_count_, [&](size_t batch) {
+        MomentumQueryScratch scratch;
+        vector<MomentumPrediction> predictions;
+        size_t end = std::min(momentum_testing_points_.size(), (batch + 1) * kBatchSize_);
+        for (size_t i = batch * kBatchSize_; i < end; i++) {
+            const MomentumPoint& point = momentum_testing_points_[i];
+            model.PredictMomentumCurve(maximum_k, point.price_increase_probability, point.price_decrease_probability,
+                                       point.static_price_probability, scratch, predictions);
+            for (size_t k = minimum_k; k <= maximum_k; k++) {
+                if (predictions[k].trend_id == point.momentum_trend) {
+                    correct_counts[batch][k - minimum_k]++;
+                }
+            }
         }
+    });
+
+    vector<double> validation_accuracies(maximum_k - minimum_k + 1);
+    for (size_t k = minimum_k; k <= maximum_k; k++) {
+        size_t correct_count = 0;
+        for (const vector<size_t>& batch_correct_counts : correct_counts) {
+            correct_count += batch_correct_counts[k - minimum_k];
+        }
+        validation_accuracies[k - minimum_k] = static_cast<double>(correct_count) / momentum_testing_points_.size();
     }
-    return validation_accuracy / momentum_testing_points_.size();
+    return validation_accuracies;
+}
+
+void MomentumClassifier::SetThreadCount(size_t thread_count) {
+    thread_count_ = thread_count;
 }
 
 }
@@ -0,0 +1,208 @@
+#include "core/momentum-prediction/momentum_distance_kernel.h"
+#include "core/cpu_features.h"
+#include <algorithm>
+#include <stdexcept>
+
+using std::invalid_argument;
+
+namespace finadvisor {
+
+namespace {
+
+// Query points compared against one block of momentum points before moving on to the next block
+const size_t kQueryBlockSize = 8;
+// Momentum points per block; three coordinates of this many points fit comfortably in L1 cache
+const size_t kPointBlockSize = 512;
+// Squared distances from different instruction sets differ by a few units in the last place, so points within this
+// relative margin of a squared distance threshold have their exact distances compared
+const double kSquaredDistanceMargin = 1e-12;
+
+#ifdef FINADVISOR_HAS_AVX2
+__attribute__((target("avx2,fma")))
+size_t ComputeSquaredDistancesAvx2(const double* x_coordinates, const double* y_coordinates,
+                                   const double* z_coordinates, size_t point_count, double x_query_coordinate,
+                                   double y_query_coordinate, double z_query_coordinate, double* squared_distances) {
+    const __m256d x_query = _mm256_set1_pd(x_query_coordinate);
+    const __m256d y_query = _mm256_set1_pd(y_query_coordinate);
+    const __m256d z_query = _mm256_set1_pd(z_query_coordinate);
+    size_t point = 0;
+    for (; point + 4 <= point_count; point += 4) {
+        __m256d x_difference = _mm256_sub_pd(x_query, _mm256_loadu_pd(x_coordinates + point));
+        __m256d y_difference = _mm256_sub_pd(y_query, _mm256_loadu_pd(y_coordinates + point));
+        __m256d z_difference = _mm256_sub_pd(z_query, _mm256_loadu_pd(z_coordinates + point));
+        __m256d squared_distance = _mm256_fmadd_pd(x_difference, x_difference,
+                                                   _mm256_fmadd_pd(y_difference, y_difference,
+                                                                   _mm256_mul_pd(z_difference, z_difference)));
+        _mm256_storeu_pd(squared_distances + point, squared_distance);
+    }
+    return point;
+}
+#endif
+
+#ifdef FINADVISOR_HAS_SSE2
+size_t ComputeSquaredDistancesSse2(const double* x_coordinates, const double* y_coordinates,
+                                   const double* z_coordinates, size_t point_count, double x_query_coordinate,
+                                   double y_query_coordinate, double z_query_coordinate, double* squared_distances) {
+    const __m128d x_query = _mm_set1_pd(x_query_coordinate);
+    const __m128d y_query = _mm_set1_pd(y_query_coordinate);
+    const __m128d z_query = _mm_set1_pd(z_query_coordinate);
+    size_t point = 0;
+    for (; point + 2 <= point_count; point += 2) {
+        __m128d x_difference = _mm_sub_pd(x_query, _mm_loadu_pd(x_coordinates + point));
+        __m128d y_difference = _mm_sub_pd(y_query, _mm_loadu_pd(y_coordinates + point));
+        __m128d z_difference = _mm_sub_pd(z_query, _mm_loadu_pd(z_coordinates + point));
+        __m128d squared_distance = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x_difference, x_difference),
+                                                         _mm_mul_pd(y_difference, y_difference)),
+                                              _mm_mul_pd(z_difference, z_difference));
+        _mm_storeu_pd(squared_distances + point, squared_distance);
+    }
+    return point;
+}
+#endif
+
+bool CompareNeighbors(const MomentumNeighbor& first_neighbor, const MomentumNeighbor& second_neighbor) {
+    if (first_neighbor.distance != second_neighbor.distance) {
+        return first_neighbor.distance < second_neighbor.distance;
+    }
+    return first_neighbor.point_index < second_neighbor.point_index;
+}
+
+double GetUpperMargin(double squared_distance) {
+    return squared_distance + squared_distance * kSquaredDistanceMargin + 1e-300;
+}
+
+double ComputeExactDistance(const MomentumPointArrays& points, size_t point, double x_query_coordinate,
+                            double y_query_coordinate, double z_query_coordinate) {
+    return ComputeMomentumDistance(x_query_coordinate - points.x_coordinates[point],
+                                   y_query_coordinate - points.y_coordinates[point],
+                                   z_query_coordinate - points.z_coordinates[point]);
+}
+
+}
+
+void ComputeSquaredMomentumDistances(const MomentumPointArrays& points, double x_query_coordinate,
+                                     double y_query_coordinate, double z_query_coordinate, double* squared_distances) {
+    size_t point = 0;
+#ifdef FINADVISOR_HAS_AVX2
+    if (SupportsAvx2Fma()) {
+        point = ComputeSquaredDistancesAvx2(points.x_coordinates, points.y_coordinates, points.z_coordinates,
+                                            points.point_count, x_query_coordinate, y_query_coordinate,
+                                            z_query_coordinate, squared_distances);
+    }
+#endif
+#ifdef FINADVISOR_HAS_SSE2
+    point += ComputeSquaredDistancesSse2(points.x_coordinates + point, points.y_coordinates + point,
+                                         points.z_coordinates + point, points.point_count - point, x_query_coordinate,
+                                         y_query_coordinate, z_query_coordinate, squared_distances + point);
+#endif
+    for (; point < points.point_count; point++) {
+        double x_difference = x_query_coordinate - points.x_coordinates[point];
+        double y_difference = y_query_coordinate - points.y_coordinates[point];
+        double z_difference = z_query_coordinate - points.z_coordinates[point];
+        squared_distances[point] = x_difference * x_difference + y_difference * y_difference +
+                                   z_difference * z_difference;
+    }
+}
+
+void FindNearestNeighborsBatch(const MomentumPointArrays& points, const double* x_query_coordinates,
+                               const double* y_query_coordinates, const double* z_query_coordinates,
+                               size_t query_count, size_t k, vector<vector<MomentumNeighbor>>& neighbors) {
+    size_t total_weight = 0;
+    for (size_t point = 0; point < points.point_count; point++) {
+        total_weight += points.weights[point];
+    }
+    if (k > total_weight) {
+        throw invalid_argument("Index out of bounds");
+    }
+    neighbors.assign(query_count, vector<MomentumNeighbor>());
+    if (k == 0) {
+        return;
+    }
+
+    // Heaps hold the nearest points found so far by squared distance, with the farthest of them on top. Alongside,
+    // every point within the margin of the squared distance on top is kept as a candidate; since that threshold only
+    // shrinks, the candidates left at the end include every point that squared distances cannot rule out.
+    vector<double> squared_distances(kPointBlockSize);
+    vector<vector<MomentumNeighbor>> heaps(kQueryBlockSize);
+    vector<size_t> heap_weights(kQueryBlockSize);
+    vector<size_t> pruned_candidate_counts(kQueryBlockSize);
+    for (size_t query_begin = 0; query_begin < query_count; query_begin += kQueryBlockSize) {
+        size_t query_end = std::min(query_count, query_begin + kQueryBlockSize);
+        for (size_t query = query_begin; query < query_end; query++) {
+            heaps[query - query_begin].clear();
+        }
+        std::fill(heap_weights.begin(), heap_weights.end(), 0);
+        std::fill(pruned_candidate_counts.begin(), pruned_candidate_counts.end(), 0);
+        for (size_t point_begin = 0; point_begin < points.point_count; point_begin += kPointBlockSize) {
+            MomentumPointArrays block = {points.x_coordinates + point_begin, points.y_coordinates + point_begin,
+                                         points.z_coordinates + point_begin, points.weights + point_begin,
+                                         std::min(kPointBlockSize, points.point_count - point_begin)};
+            for (size_t query = query_begin; query < query_end; query++) {
+                ComputeSquaredMomentumDistances(block, x_query_coordinates[query], y_query_coordinates[query],
+                                                z_query_coordinates[query], squared_distances.data());
+                vector<MomentumNeighbor>& heap = heaps[query - query_begin];
+                vector<MomentumNeighbor>& candidates = neighbors[query];
+                size_t& heap_weight = heap_weights[query - query_begin];
+                for (size_t point = 0; point < block.point_count; point++) {
+                    MomentumNeighbor neighbor = {point_begin + point, squared_distances[point], block.weights[point]};
+                    if (heap_weight >= k && neighbor.distance > GetUpperMargin(heap.front().distance)) {
+                        continue;
+                    }
+                    candidates.emplace_back(neighbor);
+                    if (heap_weight >= k && !CompareNeighbors(neighbor, heap.front())) {
+                        continue;
+                    }
+                    heap.emplace_back(neighbor);
+                    std::push_heap(heap.begin(), heap.end(), CompareNeighbors);
+                    heap_weight += neighbor.weight;
+                    while (heap_weight - heap.front().weight >= k) {
+                        heap_weight -= heap.front().weight;
+                        std::pop_heap(heap.begin(), heap.end(), CompareNeighbors);
+                        heap.pop_back();
+                    }
+                }
+
+                // Candidates that fell outside the shrunken margin are dropped once their number has doubled, which
+                // keeps pruning linear in the candidates kept
+                size_t& pruned_candidate_count = pruned_candidate_counts[query - query_begin];
+                if (heap_weight >= k && candidates.size() > 2 * pruned_candidate_count + kPointBlockSize) {
+                    double threshold = GetUpperMargin(heap.front().distance);
+                    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                                    [threshold](const MomentumNeighbor& candidate) {
+                                                        return candidate.distance > threshold;
+                                                    }),
+                                     candidates.end());
+                    pruned_candidate_count = candidates.size();
+                }
+            }
+        }
+
+        // Rank the remaining candidates by exact distance so the result does not depend on the instruction set
+        for (size_t query = query_begin; query < query_end; query++) {
+            double threshold = GetUpperMargin(heaps[query - query_begin].front().distance);
+            vector<MomentumNeighbor>& query_neighbors = neighbors[query];
+            size_t candidate_count = 0;
+            for (const MomentumNeighbor& candidate : query_neighbors) {
+                if (candidate.distance <= threshold) {
+                    query_neighbors[candidate_count++] = {candidate.point_index,
+                                                          ComputeExactDistance(points, candidate.point_index,
+                                                                               x_query_coordinates[query],
+                                                                               y_query_coordinates[query],
+                                                                               z_query_coordinates[query]),
+                                                          candidate.weight};
+                }
+            }
+            query_neighbors.resize(candidate_count);
+            std::sort(query_neighbors.begin(), query_neighbors.end(), CompareNeighbors);
+            size_t neighbor_weight = 0;
+            size_t neighbor_count = 0;
+            while (neighbor_weight + query_neighbors[neighbor_count].weight < k) {
+                neighbor_weight += query_neighbors[neighbor_count++].weight;
+            }
+            query_neighbors[neighbor_count].weight = k - neighbor_weight;
+            query_neighbors.resize(neighbor_count + 1);
+        }
+    }
+}
+
+}
@@ -3,6 +3,8 @@
 #include "core/data_processor.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <float.h>
 
 using std::ifstream;
 using std::invalid_argument;
@@ -13,39 +15,20 @@ void MomentumModel::SetFileLine(const string& line) {
     file_line_ = line;
 }
 
-double MomentumModel::GetPriceIncreaseProbability(size_t index) {
-    if (index >= momentum_training_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return momentum_training_points_[index].price_increase_probability;
+ArrayView<double> MomentumModel::GetPriceIncreaseProbabilities() const {
+    return x_coordinates_;
 }
 
-double MomentumModel::GetPriceDecreaseProbability(size_t index) {
-    if (index >= momentum_training_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return momentum_training_points_[index].price_decrease_probability;
+ArrayView<double> MomentumModel::GetPriceDecreaseProbabilities() const {
+    return y_coordinates_;
 }
 
-double MomentumModel::GetStaticPriceProbability(size_t index) {
-    if (index >= momentum_training_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return momentum_training_points_[index].static_price_probability;
+ArrayView<double> MomentumModel::GetStaticPriceProbabilities() const {
+    return z_coordinates_;
 }
 
-double MomentumModel::GetDistance(size_t index) {
-    if (index >= momentum_training_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return momentum_training_points_[index].distance;
-}
-
-string MomentumModel::GetMomentumTrend(size_t index) {
-    if (index >= momentum_training_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return momentum_training_points_[index].momentum_trend;
+ArrayView<LabelId> MomentumModel::GetMomentumTrends() const {
+    return momentum_trends_;
 }
 
 void MomentumModel::GenerateMomentumPoint() {
@@ -61,7 +44,22 @@ void MomentumModel::GenerateMomentumPoint() {
     current_momentum_point_.price_increase_probability /= file_line_.length();
     current_momentum_point_.static_price_probability /= file_line_.length();
     current_momentum_point_.price_decrease_probability /= file_line_.length();
-    momentum_training_points_.emplace_back(current_momentum_point_);
+    // Identical momentum points with the same momentum trend are stored once along with their multiplicity
+    MomentumPointKey key = {{current_momentum_point_.price_increase_probability,
+                             current_momentum_point_.price_decrease_probability,
+                             current_momentum_point_.static_price_probability},
+                            current_momentum_point_.momentum_trend};
+    auto unique_point = unique_point_indices_.emplace(key, momentum_trends_.size());
+    if (unique_point.second) {
+        x_coordinates_.emplace_back(current_momentum_point_.price_increase_probability);
+        y_coordinates_.emplace_back(current_momentum_point_.price_decrease_probability);
+        z_coordinates_.emplace_back(current_momentum_point_.static_price_probability);
+        momentum_trends_.emplace_back(current_momentum_point_.momentum_trend);
+        point_multiplicities_.emplace_back(1);
+    } else {
+        point_multiplicities_[unique_point.first->second]++;
+    }
+    point_unique_indices_.emplace_back(unique_point.first->second);
 }
 
 istream& operator>>(istream& input, MomentumModel& model) {
@@ -93,10 +91,11 @@ istream& operator>>(istream& input, MomentumModel& model) {
         }
 
         if (!is_training_data_line) {
-            model.current_momentum_point_.momentum_trend = model.file_line_;
+            model.current_momentum_point_.momentum_trend = ParseMomentumTrend(model.file_line_);
         }
         model.GenerateMomentumPoint();
     }
+    model.BuildPointIndex();
     return input;
 }
 
@@ -114,38 +113,322 @@ MomentumModel MomentumModel::ValidateFile(const string& file_path) {
     }
 }
 
-size_t MomentumModel::GetMomentumPointCount() {
-    return momentum_training_points_.size();
+size_t MomentumModel::GetMomentumPointCount() const {
+    return point_unique_indices_.size();
+}
+
+size_t MomentumModel::GetUniquePointCount() const {
+    return momentum_trends_.size();
+}
+
+ArrayView<size_t> MomentumModel::GetPointMultiplicities() const {
+    return point_multiplicities_;
+}
+
+ArrayView<size_t> MomentumModel::GetPointUniqueIndices() const {
+    return point_unique_indices_;
+}
+
+bool MomentumModel::MomentumPointKey::operator==(const MomentumPointKey& key) const {
+    return coordinates[0] == key.coordinates[0] && coordinates[1] == key.coordinates[1] &&
+           coordinates[2] == key.coordinates[2] && momentum_trend == key.momentum_trend;
+}
+
+size_t MomentumModel::MomentumPointKeyHash::operator()(const MomentumPointKey& key) const {
+    std::hash<double> hash_coordinate;
+    size_t hash = key.momentum_trend;
+    for (double coordinate : key.coordinates) {
+        hash = hash * 31 + hash_coordinate(coordinate);
+    }
+    return hash;
 }
 
 double MomentumModel::CalculateEuclideanDistance(const MomentumPoint &current_point, double x_query_coordinate,
                                                  double y_query_coordinate, double z_query_coordinate) const {
-    double sum_squared_distance = 0;
-    sum_squared_distance = pow(x_query_coordinate - current_point.price_increase_probability, 2) +
-            pow(y_query_coordinate - current_point.price_decrease_probability, 2) +
-            pow(z_query_coordinate - current_point.static_price_probability, 2);
-    return sqrt(sum_squared_distance);
+    return ComputeMomentumDistance(x_query_coordinate - current_point.price_increase_probability,
+                                   y_query_coordinate - current_point.price_decrease_probability,
+                                   z_query_coordinate - current_point.static_price_probability);
 }
 
-bool CompareDistance(const MomentumPoint& first_point, const MomentumPoint& second_point) {
-    return first_point.distance < second_point.distance;
+void MomentumModel::BuildPointIndex() {
+    point_index_ = MomentumPointIndex(x_coordinates_, y_coordinates_, z_coordinates_, point_multiplicities_);
+}
+
+MomentumPointArrays MomentumModel::GetPointArrays() const {
+    return {x_coordinates_.data(), y_coordinates_.data(), z_coordinates_.data(), point_multiplicities_.data(),
+            x_coordinates_.size()};
+}
+
+bool MomentumModel::IsPointIndexCurrent() const {
+    return point_index_.GetTotalWeight() == point_unique_indices_.size();
+}
+
+void MomentumModel::UpdatePointIndex() {
+    if (!IsPointIndexCurrent()) {
+        BuildPointIndex();
+    }
 }
 
 double MomentumModel::ComputeKNearestLabelsAverage(size_t k, double x_query_coordinate, double y_query_coordinate,
                                                    double z_query_coordinate) {
-    for (MomentumPoint& point : momentum_training_points_) {
-        point.distance = CalculateEuclideanDistance(point, x_query_coordinate, y_query_coordinate, z_query_coordinate);
+    UpdatePointIndex();
+    MomentumQueryScratch scratch;
+    return ComputeKNearestLabelsAverage(k, x_query_coordinate, y_query_coordinate, z_query_coordinate, scratch);
+}
+
+double MomentumModel::ComputeKNearestLabelsAverage(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                                   double z_query_coordinate, MomentumQueryScratch& scratch) const {
+    double upper_quartile_distance;
+    double lower_quartile_distance;
+    FindNeighborsAndQuartiles(k, x_query_coordinate, y_query_coordinate, z_query_coordinate, scratch,
+                              upper_quartile_distance, lower_quartile_distance);
+    return AverageNeighborLabels(k, scratch.neighbors, upper_quartile_distance, lower_quartile_distance);
+}
+
+void MomentumModel::PredictMomentumCurve(size_t maximum_k, double x_query_coordinate, double y_query_coordinate,
+                                         double z_query_coordinate, MomentumQueryScratch& scratch,
+                                         vector<MomentumPrediction>& predictions) const {
+    double upper_quartile_distance;
+    double lower_quartile_distance;
+    FindNeighborsAndQuartiles(maximum_k, x_query_coordinate, y_query_coordinate, z_query_coordinate, scratch,
+                              upper_quartile_distance, lower_quartile_distance);
+    predictions.resize(maximum_k + 1);
+    // Averages over zero neighbors are not a number and match no momentum point
+    predictions[0] = {std::nan(""), kNoLabel_};
+    // Neighbors of smaller k are a prefix of the neighbors of maximum_k, so each sum extends the previous one in the
+    // order AverageNeighborLabels adds labels
+    double labels_sum = 0;
+    size_t k = 0;
+    for (const MomentumNeighbor& neighbor : scratch.neighbors) {
+        double label = pow(neighbor.distance - upper_quartile_distance - lower_quartile_distance, 2);
+        for (size_t i = 0; i < neighbor.weight; i++) {
+            labels_sum += label;
+            k++;
+            MomentumPrediction& prediction = predictions[k];
+            prediction.k_nearest_labels_average = labels_sum / k;
+            if (prediction.k_nearest_labels_average == predictions[k - 1].k_nearest_labels_average) {
+                prediction.trend_id = predictions[k - 1].trend_id;
+            } else {
+                prediction.trend_id = FindTrendIdAtDistance(prediction.k_nearest_labels_average, x_query_coordinate,
+                                                            y_query_coordinate, z_query_coordinate);
+            }
+        }
+    }
+}
+
+void MomentumModel::FindNeighborsAndQuartiles(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                              double z_query_coordinate, MomentumQueryScratch& scratch,
+                                              double& upper_quartile_distance,
+                                              double& lower_quartile_distance) const {
+    // Quartiles and k count every momentum point, so unique points count as many times as their multiplicity
+    size_t point_count = point_unique_indices_.size();
+    if (point_count == 0 || k > point_count) {
+        throw invalid_argument("Index out of bounds");
+    }
+    size_t upper_quartile_rank = static_cast<size_t>(floor(kThreeQuarters_ * point_count));
+    size_t lower_quartile_rank = static_cast<size_t>(floor(kOneQuarters_ * point_count));
+    if (IsPointIndexCurrent()) {
+        point_index_.FindNearestNeighbors(k, x_query_coordinate, y_query_coordinate, z_query_coordinate,
+                                          scratch.neighbors);
+        upper_quartile_distance = point_index_.FindDistanceAtRank(upper_quartile_rank, x_query_coordinate,
+                                                                  y_query_coordinate, z_query_coordinate,
+                                                                  scratch.candidates);
+        lower_quartile_distance = point_index_.FindDistanceAtRank(lower_quartile_rank, x_query_coordinate,
+                                                                  y_query_coordinate, z_query_coordinate,
+                                                                  scratch.candidates);
+    } else {
+        // Select the quartiles and the k nearest distances rather than sorting every distance
+        vector<MomentumNeighbor>& candidates = scratch.candidates;
+        candidates.clear();
+        for (size_t i = 0; i < momentum_trends_.size(); i++) {
+            candidates.push_back({i, ComputeMomentumDistance(x_query_coordinate - x_coordinates_[i],
+                                                             y_query_coordinate - y_coordinates_[i],
+                                                             z_query_coordinate - z_coordinates_[i]),
+                                  point_multiplicities_[i]});
+        }
+        upper_quartile_distance = SelectDistanceAtRank(candidates, upper_quartile_rank);
+        lower_quartile_distance = SelectDistanceAtRank(candidates, lower_quartile_rank);
+        scratch.neighbors.clear();
+        if (k > 0) {
+            double farthest_distance = SelectDistanceAtRank(candidates, k - 1);
+            for (const MomentumNeighbor& candidate : candidates) {
+                if (candidate.distance <= farthest_distance) {
+                    scratch.neighbors.emplace_back(candidate);
+                }
+            }
+            std::sort(scratch.neighbors.begin(), scratch.neighbors.end(),
+                      [](const MomentumNeighbor& first_neighbor, const MomentumNeighbor& second_neighbor) {
+                          return first_neighbor.distance < second_neighbor.distance;
+                      });
+            // Keep only as many momentum points as are needed to make up k
+            size_t neighbor_weight = 0;
+            size_t neighbor_count = 0;
+            while (neighbor_weight + scratch.neighbors[neighbor_count].weight < k) {
+                neighbor_weight += scratch.neighbors[neighbor_count++].weight;
+            }
+            scratch.neighbors[neighbor_count].weight = k - neighbor_weight;
+            scratch.neighbors.resize(neighbor_count + 1);
+        }
+    }
+}
+
+void MomentumModel::ComputeKNearestLabelsAverages(size_t k, const vector<double>& x_query_coordinates,
+                                                  const vector<double>& y_query_coordinates,
+                                                  const vector<double>& z_query_coordinates,
+                                                  vector<double>& k_nearest_labels_averages) const {
+    if (x_query_coordinates.size() != y_query_coordinates.size() ||
+        x_query_coordinates.size() != z_query_coordinates.size()) {
+        throw invalid_argument("Coordinate counts differ");
+    }
+    size_t query_count = x_query_coordinates.size();
+    k_nearest_labels_averages.resize(query_count);
+    MomentumQueryScratch scratch;
+    if (!IsPointIndexCurrent()) {
+        for (size_t query = 0; query < query_count; query++) {
+            k_nearest_labels_averages[query] = ComputeKNearestLabelsAverage(k, x_query_coordinates[query],
+                                                                            y_query_coordinates[query],
+                                                                            z_query_coordinates[query], scratch);
+        }
+        return;
     }
-    // Sort the vector of momentum points in ascending order by distances
-    std::sort(momentum_training_points_.begin(), momentum_training_points_.end(), CompareDistance);
+
+    size_t point_count = point_unique_indices_.size();
+    if (point_count == 0 || k > point_count) {
+        throw invalid_argument("Index out of bounds");
+    }
+    size_t upper_quartile_rank = static_cast<size_t>(floor(kThreeQuarters_ * point_count));
+    size_t lower_quartile_rank = static_cast<size_t>(floor(kOneQuarters_ * point_count));
+    vector<vector<MomentumNeighbor>> neighbors;
+    FindNearestNeighborsBatch(GetPointArrays(), x_query_coordinates.data(), y_query_coordinates.data(),
+                              z_query_coordinates.data(), query_count, k, neighbors);
+    for (size_t query = 0; query < query_count; query++) {
+        double upper_quartile_distance = point_index_.FindDistanceAtRank(upper_quartile_rank,
+                                                                         x_query_coordinates[query],
+                                                                         y_query_coordinates[query],
+                                                                         z_query_coordinates[query],
+                                                                         scratch.candidates);
+        double lower_quartile_distance = point_index_.FindDistanceAtRank(lower_quartile_rank,
+                                                                         x_query_coordinates[query],
+                                                                         y_query_coordinates[query],
+                                                                         z_query_coordinates[query],
+                                                                         scratch.candidates);
+        k_nearest_labels_averages[query] = AverageNeighborLabels(k, neighbors[query], upper_quartile_distance,
+                                                                 lower_quartile_distance);
+    }
+}
+
+double MomentumModel::AverageNeighborLabels(size_t k, const vector<MomentumNeighbor>& neighbors,
+                                            double upper_quartile_distance, double lower_quartile_distance) const {
     double k_nearest_labels_average = 0;
     // Label refers to the squared deviations from the semi-interquartile range
-    for (size_t i = 0; i < k; i++) {
-        k_nearest_labels_average += pow(momentum_training_points_[i].distance -
-                                        (momentum_training_points_[floor(kThreeQuarters_ * momentum_training_points_.size())].distance) -
-                                        (momentum_training_points_[floor(kOneQuarters_ * momentum_training_points_.size())].distance), 2);
+    for (const MomentumNeighbor& neighbor : neighbors) {
+        double label = pow(neighbor.distance - upper_quartile_distance - lower_quartile_distance, 2);
+        // Add once per momentum point so the sum rounds exactly as it would over every momentum point
+        for (size_t i = 0; i < neighbor.weight; i++) {
+            k_nearest_labels_average += label;
+        }
     }
     return k_nearest_labels_average / k;
 }
 
-}
\ No newline at end of file
+size_t MomentumModel::FindPointAtDistance(double target_distance, double x_query_coordinate,
+                                         double y_query_coordinate, double z_query_coordinate) const {
+    if (momentum_trends_.empty()) {
+        throw invalid_argument("Index out of bounds");
+    }
+    if (IsPointIndexCurrent()) {
+        return point_index_.FindClosestDistance(target_distance, x_query_coordinate, y_query_coordinate,
+                                                z_query_coordinate).point_index;
+    }
+    // Ties go to the nearer momentum point, then to the earlier one, as they do in the point index
+    size_t closest_index = 0;
+    double closest_distance = DBL_MAX;
+    double closest_gap = DBL_MAX;
+    for (size_t i = 0; i < momentum_trends_.size(); i++) {
+        double distance = ComputeMomentumDistance(x_query_coordinate - x_coordinates_[i],
+                                                  y_query_coordinate - y_coordinates_[i],
+                                                  z_query_coordinate - z_coordinates_[i]);
+        double gap = std::abs(distance - target_distance);
+        if (gap < closest_gap || (gap == closest_gap && distance < closest_distance)) {
+            closest_index = i;
+            closest_distance = distance;
+            closest_gap = gap;
+        }
+    }
+    return closest_index;
+}
+
+LabelId MomentumModel::FindTrendIdAtDistance(double target_distance, double x_query_coordinate,
+                                             double y_query_coordinate, double z_query_coordinate) const {
+    return momentum_trends_[FindPointAtDistance(target_distance, x_query_coordinate, y_query_coordinate,
+                                                z_query_coordinate)];
+}
+
+MomentumPrediction MomentumModel::SearchMomentum(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                                double z_query_coordinate, MomentumQueryScratch& scratch) const {
+    MomentumPrediction prediction;
+    prediction.k_nearest_labels_average = ComputeKNearestLabelsAverage(k, x_query_coordinate, y_query_coordinate,
+                                                                       z_query_coordinate, scratch);
+    prediction.trend_id = kNoLabel_;
+    if (!std::isnan(prediction.k_nearest_labels_average)) {
+        prediction.trend_id = FindTrendIdAtDistance(prediction.k_nearest_labels_average, x_query_coordinate,
+                                                    y_query_coordinate, z_query_coordinate);
+    }
+    return prediction;
+}
+
+void MomentumModel::BuildInferenceTable(size_t k, size_t maximum_day_count) {
+    UpdatePointIndex();
+    inference_table_.clear();
+    inference_day_offsets_.assign(1, 0);
+    MomentumQueryScratch scratch;
+    for (size_t day_count = 1; day_count <= maximum_day_count; day_count++) {
+        double length = static_cast<double>(day_count);
+        inference_day_offsets_.emplace_back(inference_table_.size());
+        for (size_t increase_count = 0; increase_count <= day_count; increase_count++) {
+            for (size_t decrease_count = 0; increase_count + decrease_count <= day_count; decrease_count++) {
+                // Divide counts the same way GenerateMomentumPoint does
+                inference_table_.emplace_back(SearchMomentum(
+                        k, static_cast<double>(increase_count) / length, static_cast<double>(decrease_count) / length,
+                        static_cast<double>(day_count - increase_count - decrease_count) / length, scratch));
+            }
+        }
+    }
+    inference_k_ = k;
+    inference_point_count_ = point_unique_indices_.size();
+}
+
+bool MomentumModel::FindInferenceEntry(double x_query_coordinate, double y_query_coordinate,
+                                       double z_query_coordinate, size_t& entry) const {
+    for (size_t day_count = 1; day_count < inference_day_offsets_.size(); day_count++) {
+        double length = static_cast<double>(day_count);
+        double increase_count = std::round(x_query_coordinate * length);
+        double decrease_count = std::round(y_query_coordinate * length);
+        if (!(increase_count >= 0 && decrease_count >= 0 && increase_count + decrease_count <= length)) {
+            continue;
+        }
+        double static_count = length - increase_count - decrease_count;
+        if (increase_count / length == x_query_coordinate && decrease_count / length == y_query_coordinate &&
+            static_count / length == z_query_coordinate) {
+            size_t increase = static_cast<size_t>(increase_count);
+            // Month of day_count days has day_count + 1 - i points with price increase count i
+            entry = inference_day_offsets_[day_count] + increase * (day_count + 1) - increase * (increase - 1) / 2 +
+                    static_cast<size_t>(decrease_count);
+            return true;
+        }
+    }
+    return false;
+}
+
+MomentumPrediction MomentumModel::PredictMomentum(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                                  double z_query_coordinate, MomentumQueryScratch& scratch) const {
+    size_t entry;
+    if (k == inference_k_ && inference_point_count_ == point_unique_indices_.size() &&
+        FindInferenceEntry(x_query_coordinate, y_query_coordinate, z_query_coordinate, entry)) {
+        return inference_table_[entry];
+    }
+    // Query point is off the lattice or the table was built for another model or k
+    return SearchMomentum(k, x_query_coordinate, y_query_coordinate, z_query_coordinate, scratch);
+}
+
+}
@@ -0,0 +1,338 @@
+#include "core/momentum-prediction/momentum_point_index.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using std::invalid_argument;
+
+namespace finadvisor {
+
+namespace {
+
+bool CompareNeighbors(const MomentumNeighbor& first_neighbor, const MomentumNeighbor& second_neighbor) {
+    if (first_neighbor.distance != second_neighbor.distance) {
+        return first_neighbor.distance < second_neighbor.distance;
+    }
+    return first_neighbor.point_index < second_neighbor.point_index;
+}
+
+}
+
+double SelectDistanceAtRank(vector<MomentumNeighbor>& neighbors, size_t rank) {
+    size_t begin = 0;
+    size_t end = neighbors.size();
+    while (begin < end) {
+        // Partition around the middle neighbor, then continue in whichever side holds the rank
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element(neighbors.begin() + begin, neighbors.begin() + middle, neighbors.begin() + end,
+                         CompareNeighbors);
+        size_t lower_weight = 0;
+        for (size_t i = begin; i < middle; i++) {
+            lower_weight += neighbors[i].weight;
+        }
+        if (rank < lower_weight) {
+            end = middle;
+        } else if (rank < lower_weight + neighbors[middle].weight) {
+            return neighbors[middle].distance;
+        } else {
+            rank -= lower_weight + neighbors[middle].weight;
+            begin = middle + 1;
+        }
+    }
+    throw invalid_argument("Index out of bounds");
+}
+
+MomentumPointIndex::MomentumPointIndex(const vector<double>& x_coordinates, const vector<double>& y_coordinates,
+                                       const vector<double>& z_coordinates)
+        : MomentumPointIndex(x_coordinates, y_coordinates, z_coordinates, vector<size_t>(x_coordinates.size(), 1)) {
+}
+
+MomentumPointIndex::MomentumPointIndex(const vector<double>& x_coordinates, const vector<double>& y_coordinates,
+                                       const vector<double>& z_coordinates, const vector<size_t>& weights) {
+    if (x_coordinates.size() != y_coordinates.size() || x_coordinates.size() != z_coordinates.size() ||
+        x_coordinates.size() != weights.size()) {
+        throw invalid_argument("Coordinate counts differ");
+    }
+    vector<size_t> point_indices(x_coordinates.size());
+    std::iota(point_indices.begin(), point_indices.end(), 0);
+    const vector<double>* coordinates[3] = {&x_coordinates, &y_coordinates, &z_coordinates};
+    if (!point_indices.empty()) {
+        nodes_.reserve(2 * (point_indices.size() / kLeafSize_ + 1));
+        BuildNode(point_indices, 0, point_indices.size(), coordinates, weights);
+    }
+
+    // Lay out coordinates in tree order so every leaf scans contiguous memory
+    x_coordinates_.reserve(point_indices.size());
+    y_coordinates_.reserve(point_indices.size());
+    z_coordinates_.reserve(point_indices.size());
+    weights_.reserve(point_indices.size());
+    for (size_t point_index : point_indices) {
+        x_coordinates_.emplace_back(x_coordinates[point_index]);
+        y_coordinates_.emplace_back(y_coordinates[point_index]);
+        z_coordinates_.emplace_back(z_coordinates[point_index]);
+        weights_.emplace_back(weights[point_index]);
+    }
+    point_indices_ = std::move(point_indices);
+}
+
+size_t MomentumPointIndex::BuildNode(vector<size_t>& point_indices, size_t begin, size_t end,
+                                     const vector<double>* coordinates[3], const vector<size_t>& weights) {
+    size_t node_index = nodes_.size();
+    nodes_.emplace_back();
+    Node node;
+    node.begin = begin;
+    node.end = end;
+    node.weight = 0;
+    for (size_t position = begin; position < end; position++) {
+        node.weight += weights[point_indices[position]];
+    }
+    node.left = kNoChild_;
+    node.right = kNoChild_;
+    for (size_t axis = 0; axis < 3; axis++) {
+        node.minimum[axis] = std::numeric_limits<double>::infinity();
+        node.maximum[axis] = -std::numeric_limits<double>::infinity();
+        for (size_t position = begin; position < end; position++) {
+            double coordinate = (*coordinates[axis])[point_indices[position]];
+            node.minimum[axis] = std::min(node.minimum[axis], coordinate);
+            node.maximum[axis] = std::max(node.maximum[axis], coordinate);
+        }
+    }
+
+    if (end - begin > kLeafSize_) {
+        // Split along the widest axis at the median so the tree stays balanced
+        size_t split_axis = 0;
+        for (size_t axis = 1; axis < 3; axis++) {
+            if (node.maximum[axis] - node.minimum[axis] > node.maximum[split_axis] - node.minimum[split_axis]) {
+                split_axis = axis;
+            }
+        }
+        const vector<double>& split_coordinates = *coordinates[split_axis];
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element(point_indices.begin() + begin, point_indices.begin() + middle, point_indices.begin() + end,
+                         [&split_coordinates](size_t first_index, size_t second_index) {
+                             return split_coordinates[first_index] < split_coordinates[second_index];
+                         });
+        node.left = BuildNode(point_indices, begin, middle, coordinates, weights);
+        node.right = BuildNode(point_indices, middle, end, coordinates, weights);
+    }
+    nodes_[node_index] = node;
+    return node_index;
+}
+
+size_t MomentumPointIndex::GetPointCount() const {
+    return point_indices_.size();
+}
+
+size_t MomentumPointIndex::GetTotalWeight() const {
+    return nodes_.empty() ? 0 : nodes_[0].weight;
+}
+
+double MomentumPointIndex::Query::GetMinimumDistance(const Node& node) const {
+    double squared_distance = 0;
+    for (size_t axis = 0; axis < 3; axis++) {
+        double gap = std::max(0.0, std::max(node.minimum[axis] - coordinates[axis],
+                                            coordinates[axis] - node.maximum[axis]));
+        squared_distance += gap * gap;
+    }
+    return sqrt(squared_distance);
+}
+
+double MomentumPointIndex::Query::GetMaximumDistance(const Node& node) const {
+    double squared_distance = 0;
+    for (size_t axis = 0; axis < 3; axis++) {
+        double gap = std::max(std::abs(coordinates[axis] - node.minimum[axis]),
+                              std::abs(coordinates[axis] - node.maximum[axis]));
+        squared_distance += gap * gap;
+    }
+    return sqrt(squared_distance);
+}
+
+double MomentumPointIndex::GetTolerance(double distance) {
+    return 1e-12 * (1 + std::abs(distance));
+}
+
+double MomentumPointIndex::GetDistance(const Query& query, size_t position) const {
+    return ComputeMomentumDistance(query.coordinates[0] - x_coordinates_[position],
+                                   query.coordinates[1] - y_coordinates_[position],
+                                   query.coordinates[2] - z_coordinates_[position]);
+}
+
+void MomentumPointIndex::FindNearestNeighbors(size_t k, double x_query_coordinate, double y_query_coordinate,
+                                              double z_query_coordinate, vector<MomentumNeighbor>& neighbors) const {
+    if (k > GetTotalWeight()) {
+        throw invalid_argument("Index out of bounds");
+    }
+    neighbors.clear();
+    if (k == 0) {
+        return;
+    }
+    Query query = {{x_query_coordinate, y_query_coordinate, z_query_coordinate}};
+    size_t neighbor_weight = 0;
+    SearchNearest(0, query, k, neighbors, neighbor_weight);
+    std::sort_heap(neighbors.begin(), neighbors.end(), CompareNeighbors);
+    // The farthest neighbor may stand for more points than are needed to make up k
+    neighbors.back().weight -= neighbor_weight - k;
+}
+
+void MomentumPointIndex::SearchNearest(size_t node_index, const Query& query, size_t k,
+                                       vector<MomentumNeighbor>& neighbors, size_t& neighbor_weight) const {
+    const Node& node = nodes_[node_index];
+    // Neighbors are kept as a max heap so the farthest of the nearest points found so far is always on top
+    if (neighbor_weight >= k &&
+        query.GetMinimumDistance(node) - GetTolerance(neighbors.front().distance) > neighbors.front().distance) {
+        return;
+    }
+    if (node.left == kNoChild_) {
+        for (size_t position = node.begin; position < node.end; position++) {
+            MomentumNeighbor neighbor = {point_indices_[position], GetDistance(query, position), weights_[position]};
+            if (neighbor_weight >= k && !CompareNeighbors(neighbor, neighbors.front())) {
+                continue;
+            }
+            neighbors.emplace_back(neighbor);
+            std::push_heap(neighbors.begin(), neighbors.end(), CompareNeighbors);
+            neighbor_weight += neighbor.weight;
+            // Drop the farthest neighbor once the others make up k without it
+            while (neighbor_weight - neighbors.front().weight >= k) {
+                neighbor_weight -= neighbors.front().weight;
+                std::pop_heap(neighbors.begin(), neighbors.end(), CompareNeighbors);
+                neighbors.pop_back();
+            }
+        }
+        return;
+    }
+    // Descend into the nearer child first so the farther one is more likely to be pruned
+    size_t near_child = node.left;
+    size_t far_child = node.right;
+    if (query.GetMinimumDistance(nodes_[far_child]) < query.GetMinimumDistance(nodes_[near_child])) {
+        std::swap(near_child, far_child);
+    }
+    SearchNearest(near_child, query, k, neighbors, neighbor_weight);
+    SearchNearest(far_child, query, k, neighbors, neighbor_weight);
+}
+
+void MomentumPointIndex::CountWithin(size_t node_index, const Query& query, double radius, size_t& point_count,
+                                     size_t& weight) const {
+    const Node& node = nodes_[node_index];
+    double tolerance = GetTolerance(radius);
+    if (query.GetMinimumDistance(node) - tolerance > radius) {
+        return;
+    }
+    if (query.GetMaximumDistance(node) + tolerance <= radius) {
+        point_count += node.end - node.begin;
+        weight += node.weight;
+        return;
+    }
+    if (node.left == kNoChild_) {
+        for (size_t position = node.begin; position < node.end; position++) {
+            if (GetDistance(query, position) <= radius) {
+                point_count++;
+                weight += weights_[position];
+            }
+        }
+        return;
+    }
+    CountWithin(node.left, query, radius, point_count, weight);
+    CountWithin(node.right, query, radius, point_count, weight);
+}
+
+void MomentumPointIndex::CollectBetween(size_t node_index, const Query& query, double lower_radius,
+                                        double upper_radius, vector<MomentumNeighbor>& candidates) const {
+    const Node& node = nodes_[node_index];
+    if (query.GetMinimumDistance(node) - GetTolerance(upper_radius) > upper_radius ||
+        query.GetMaximumDistance(node) + GetTolerance(lower_radius) <= lower_radius) {
+        return;
+    }
+    if (node.left == kNoChild_) {
+        for (size_t position = node.begin; position < node.end; position++) {
+            double distance = GetDistance(query, position);
+            if (distance > lower_radius && distance <= upper_radius) {
+                candidates.push_back({point_indices_[position], distance, weights_[position]});
+            }
+        }
+        return;
+    }
+    CollectBetween(node.left, query, lower_radius, upper_radius, candidates);
+    CollectBetween(node.right, query, lower_radius, upper_radius, candidates);
+}
+
+double MomentumPointIndex::FindDistanceAtRank(size_t rank, double x_query_coordinate, double y_query_coordinate,
+                                              double z_query_coordinate) const {
+    vector<MomentumNeighbor> candidates;
+    return FindDistanceAtRank(rank, x_query_coordinate, y_query_coordinate, z_query_coordinate, candidates);
+}
+
+double MomentumPointIndex::FindDistanceAtRank(size_t rank, double x_query_coordinate, double y_query_coordinate,
+                                              double z_query_coordinate, vector<MomentumNeighbor>& candidates) const {
+    if (rank >= GetTotalWeight()) {
+        throw invalid_argument("Index out of bounds");
+    }
+    Query query = {{x_query_coordinate, y_query_coordinate, z_query_coordinate}};
+    // Bisect on a radius until few points lie between the radius containing at most rank weight and the radius
+    // containing more than rank weight; the answer is then among those points.
+    double lower_radius = -1;
+    size_t lower_point_count = 0;
+    size_t lower_weight = 0;
+    double upper_radius = query.GetMaximumDistance(nodes_[0]) + 1;
+    size_t upper_point_count = GetPointCount();
+    for (size_t bisection = 0; bisection < kMaximumBisectionCount_ &&
+                               upper_point_count - lower_point_count > kRankCandidateCount_; bisection++) {
+        double middle_radius = lower_radius + (upper_radius - lower_radius) / 2;
+        if (middle_radius <= lower_radius || middle_radius >= upper_radius) {
+            break;
+        }
+        size_t middle_point_count = 0;
+        size_t middle_weight = 0;
+        CountWithin(0, query, middle_radius, middle_point_count, middle_weight);
+        if (middle_weight > rank) {
+            upper_radius = middle_radius;
+            upper_point_count = middle_point_count;
+        } else {
+            lower_radius = middle_radius;
+            lower_point_count = middle_point_count;
+            lower_weight = middle_weight;
+        }
+    }
+
+    candidates.clear();
+    CollectBetween(0, query, lower_radius, upper_radius, candidates);
+    return SelectDistanceAtRank(candidates, rank - lower_weight);
+}
+
+MomentumNeighbor MomentumPointIndex::FindClosestDistance(double target_distance, double x_query_coordinate,
+                                                         double y_query_coordinate, double z_query_coordinate) const {
+    if (GetPointCount() == 0) {
+        throw invalid_argument("Index out of bounds");
+    }
+    Query query = {{x_query_coordinate, y_query_coordinate, z_query_coordinate}};
+    MomentumNeighbor closest = {point_indices_[0], GetDistance(query, 0), weights_[0]};
+    double closest_gap = std::abs(closest.distance - target_distance);
+    SearchClosestDistance(0, query, target_distance, closest, closest_gap);
+    return closest;
+}
+
+void MomentumPointIndex::SearchClosestDistance(size_t node_index, const Query& query, double target_distance,
+                                               MomentumNeighbor& closest, double& closest_gap) const {
+    const Node& node = nodes_[node_index];
+    // No point of the node can be nearer the target than the gap between the target and the node's distance range
+    double node_gap = std::max(0.0, std::max(query.GetMinimumDistance(node) - target_distance,
+                                             target_distance - query.GetMaximumDistance(node)));
+    if (node_gap - GetTolerance(target_distance) > closest_gap) {
+        return;
+    }
+    if (node.left == kNoChild_) {
+        for (size_t position = node.begin; position < node.end; position++) {
+            MomentumNeighbor candidate = {point_indices_[position], GetDistance(query, position), weights_[position]};
+            double gap = std::abs(candidate.distance - target_distance);
+            if (gap < closest_gap || (gap == closest_gap && CompareNeighbors(candidate, closest))) {
+                closest = candidate;
+                closest_gap = gap;
+            }
+        }
+        return;
+    }
+    SearchClosestDistance(node.left, query, target_distance, closest, closest_gap);
+    SearchClosestDistance(node.right, query, target_distance, closest, closest_gap);
+}
+
+}
@@ -1,45 +1,48 @@
 #include "core/momentum-prediction/momentum_training_data_factory.h"
 #include <fstream>
 #include <vector>
-#include "core/data_processor.h"
 #include "core/date.h"
 #include <sstream>
 #include "core/momentum-prediction/momentum_calculator.h"
+#include "core/parallel.h"
+#include "core/price_kernels.h"
 #include <codecvt>
 #include <iostream>
 
 using std::istreambuf_iterator;
 using std::count;
-using std::ifstream;
-using std::invalid_argument;
-using std::stod;
 using std::stringstream;
 
 namespace finadvisor {
 
-Momentum MomentumTrainingDataFactory::GetMomentum(size_t map_index) {
-    std::pair<const vector<double>, Momentum> &nth_element = *std::next(momentum_by_price_difference_.begin(), map_index);
-    return nth_element.second;
+Momentum MomentumTrainingDataFactory::GetMomentum(size_t month_index) const {
+    return momentum_by_month_.GetLabel(month_index);
 }
 
-std::vector<double> MomentumTrainingDataFactory::GetPriceDifferences(size_t map_index) {
-    std::pair<const vector<double>, Momentum> &nth_element = *std::next(momentum_by_price_difference_.begin(), map_index);
-    return nth_element.first;
+std::vector<double> MomentumTrainingDataFactory::GetPriceDifferences(size_t month_index) const {
+    return momentum_by_month_.GetValues(month_index);
+}
+
+size_t MomentumTrainingDataFactory::FindMonth(size_t series_index, size_t year, size_t month) const {
+    return momentum_by_month_.FindMonth(series_index, year, month);
 }
 
 ostream& operator<<(ostream& output, MomentumTrainingDataFactory& factory) {
-    for (const auto& pair : factory.momentum_by_price_difference_) {\
-        output << kMomentumCategories_[static_cast<int>(pair.second.category)] << " " <<
-            kMomentumDirections_[static_cast<int>(pair.second.direction)];
+    const MonthTable<Momentum>& table = factory.momentum_by_month_;
+    for (size_t month_index = 0; month_index < table.GetMonthCount(); month_index++) {
+        const Momentum& momentum = table.GetLabel(month_index);
+        output << kMomentumCategories_[static_cast<int>(momentum.category)] << " " <<
+            kMomentumDirections_[static_cast<int>(momentum.direction)];
         output << kNewLineCharacter_;
         std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-        for (double price_difference : pair.first) {
+        for (const double* price_difference = table.GetValuesBegin(month_index);
+             price_difference != table.GetValuesEnd(month_index); price_difference++) {
             // Code below derived from:
             // https://stackoverflow.com/questions/18534494/convert-from-utf-8-to-unicode-c
-            if (price_difference > 0) {
+            if (*price_difference > 0) {
                 // Encode - Convert character of type Utf8 to unicode
                 output << converter.from_bytes(kUpwardTrendCharacter_).c_str();
-            } else if (price_difference < 0) {
+            } else if (*price_difference < 0) {
                 output << converter.from_bytes(kDownwardTrendCharacter_).c_str();
             } else {
                 output << converter.from_bytes(kStaticTrendCharacter_).c_str();
@@ -68,42 +71,127 @@ string MomentumTrainingDataFactory::WriteToOutputFile(MomentumTrainingDataFactor
     return kMomentumOutputFilePath_;
 }
 
+void MomentumTrainingDataFactory::InsertCurrentMonth() {
+    MomentumCalculator calculator;
+    momentum_by_month_.Append(series_index_, month_key_, price_differences_,
+                              calculator.IdentifyMomentum(price_differences_));
+    price_differences_.clear();
+}
+
+void MomentumTrainingDataFactory::UpdatePriceDifferences(size_t series_index, const Date& date,
+                                                         double price_difference) {
+    // The first row of a new series always closes out the month left open by the previous series
+    if ((series_index_ != series_index || month_key_ != date.GetMonthKey()) && !price_differences_.empty()) {
+        InsertCurrentMonth();
+    }
+    if (rolling_window_length_ > 0) {
+        // Rolling windows never span two series
+        if (series_index_ != series_index) {
+            rolling_window_.Clear();
+        }
+        rolling_window_.Add(price_difference);
+        if (rolling_window_.IsFull()) {
+            MomentumCalculator calculator;
+            rolling_momentums_.emplace_back(calculator.ClassifyMomentum(
+                    calculator.ComputeMomentumStatistics(rolling_window_)));
+            rolling_window_end_dates_.emplace_back(date);
+        }
+    }
+    series_index_ = series_index;
+    month_key_ = date.GetMonthKey();
+    price_differences_.emplace_back(price_difference);
+}
+
+void MomentumTrainingDataFactory::MergeSeries(MomentumTrainingDataFactory& series_factory) {
+    if (series_factory.momentum_by_month_.GetMonthCount() == 0 && series_factory.price_differences_.empty()) {
+        return;
+    }
+    // The first row of a new series always closes out the month left open by the previous series
+    if (!price_differences_.empty()) {
+        InsertCurrentMonth();
+    }
+    momentum_by_month_.AppendTable(series_factory.momentum_by_month_);
+    rolling_momentums_.insert(rolling_momentums_.end(), series_factory.rolling_momentums_.begin(),
+                              series_factory.rolling_momentums_.end());
+    rolling_window_end_dates_.insert(rolling_window_end_dates_.end(), series_factory.rolling_window_end_dates_.begin(),
+                                     series_factory.rolling_window_end_dates_.end());
+    price_differences_ = std::move(series_factory.price_differences_);
+    month_key_ = series_factory.month_key_;
+    series_index_ = series_factory.series_index_;
+}
+
+void MomentumTrainingDataFactory::SetThreadCount(size_t thread_count) {
+    thread_count_ = thread_count;
+}
+
+void MomentumTrainingDataFactory::SetRollingWindowLength(size_t window_length) {
+    rolling_window_length_ = window_length;
+    rolling_window_ = window_length > 0 ? RollingWindow(window_length) : RollingWindow();
+}
+
+size_t MomentumTrainingDataFactory::GetRollingWindowCount() const {
+    return rolling_momentums_.size();
+}
+
+Momentum MomentumTrainingDataFactory::GetRollingMomentum(size_t window_index) const {
+    if (window_index >= rolling_momentums_.size()) {
+        throw std::invalid_argument("Index out of bounds");
+    }
+    return rolling_momentums_[window_index];
+}
+
+Date MomentumTrainingDataFactory::GetRollingWindowEndDate(size_t window_index) const {
+    if (window_index >= rolling_window_end_dates_.size()) {
+        throw std::invalid_argument("Index out of bounds");
+    }
+    return rolling_window_end_dates_[window_index];
+}
+
+size_t MomentumTrainingDataFactory::GetMonthCount() const {
+    return momentum_by_month_.GetMonthCount();
+}
+
 istream& operator>>(istream& input, MomentumTrainingDataFactory& factory) {
     string line;
-    size_t month = 0;
+    CsvRow row;
+    // Every stream is a new price series
+    size_t series_index = factory.series_count_++;
     while (getline(input, line)) {
-        DataProcessor processor;
-        Date date(processor.Split(line, kParseCharacter_)[0]);
-        if (month != date.GetMonth() && !factory.price_differences_.empty()) {
-            MomentumCalculator calculator;
-            factory.momentum_by_price_difference_.insert({factory.price_differences_,
-                                                          calculator.IdentifyMomentum(factory.price_differences_)});
-            factory.price_differences_.clear();
+        if (row.Parse(line.data(), line.data() + line.size())) {
+            factory.UpdatePriceDifferences(series_index, row.GetDate(0), row.GetDouble(MomentumTrainingDataFactory::kOpeningPriceIndex_) -
+                                                           row.GetDouble(MomentumTrainingDataFactory::kClosingPriceIndex_));
         }
-        month = date.GetMonth();
-        factory.price_differences_.reserve(factory.price_differences_.size() + MomentumTrainingDataFactory::kOpeningPriceIndex_);
-        factory.price_differences_.emplace_back(stod(processor.Split(line, kParseCharacter_)[
-                MomentumTrainingDataFactory::kOpeningPriceIndex_]) -
-                                                stod(processor.Split(line, kParseCharacter_)[
-                                                        MomentumTrainingDataFactory::kClosingPriceIndex_]));
     }
     return input;
 }
 
-MomentumTrainingDataFactory MomentumTrainingDataFactory::ValidateFiles(const vector<string>& file_paths) const {
-    MomentumTrainingDataFactory factory;
-    ifstream file;
-    for (const string& file_path : file_paths) {
-        file.open(file_path);
-        if (file.fail() || file.bad() || file.eof()) {
-            file.close();
-            throw invalid_argument("Cannot open file");
-        } else {
-            file >> factory;
-            file.close();
+MomentumTrainingDataFactory MomentumTrainingDataFactory::LoadPriceStore(const PriceStore& store) const {
+    vector<MomentumTrainingDataFactory> series_factories(store.GetSeriesCount());
+    ParallelFor(store.GetSeriesCount(), thread_count_, [&](size_t series_index) {
+        const PriceSeries& series = store.GetSeries(series_index);
+        MomentumTrainingDataFactory& series_factory = series_factories[series_index];
+        series_factory.SetRollingWindowLength(rolling_window_length_);
+        vector<double> price_differences = ComputePriceDifferences(series);
+        for (size_t day = 0; day < series.GetDayCount(); day++) {
+            series_factory.UpdatePriceDifferences(series_index, series.dates[day], price_differences[day]);
         }
+    });
+
+    MomentumTrainingDataFactory factory;
+    factory.thread_count_ = thread_count_;
+    factory.series_count_ = store.GetSeriesCount();
+    factory.SetRollingWindowLength(rolling_window_length_);
+    for (MomentumTrainingDataFactory& series_factory : series_factories) {
+        factory.MergeSeries(series_factory);
     }
     return factory;
 }
 
-}
\ No newline at end of file
+MomentumTrainingDataFactory MomentumTrainingDataFactory::ValidateFiles(const vector<string>& file_paths) const {
+    // Throws invalid argument exception if a file cannot be opened
+    PriceStore store;
+    store.SetThreadCount(thread_count_);
+    return LoadPriceStore(store.ValidateFiles(file_paths));
+}
+
+}
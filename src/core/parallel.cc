@@ -0,0 +1,65 @@
+#include "core/parallel.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace finadvisor {
+
+size_t GetDefaultThreadCount() {
+    size_t thread_count = std::thread::hardware_concurrency();
+    return thread_count == 0 ? 1 : thread_count;
+}
+
+void ParallelFor(size_t task_count, size_t thread_count, const std::function<void(size_t)>& task) {
+    if (thread_count == 0) {
+        thread_count = GetDefaultThreadCount();
+    }
+    if (thread_count > task_count) {
+        thread_count = task_count;
+    }
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < task_count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_task(0);
+    std::exception_ptr first_exception;
+    size_t first_exception_task = task_count;
+    std::mutex exception_mutex;
+    auto worker = [&]() {
+        for (size_t i = next_task++; i < task_count; i = next_task++) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                // Keep the exception of the lowest index so the reported error does not depend on scheduling
+                if (i < first_exception_task) {
+                    first_exception = std::current_exception();
+                    first_exception_task = i;
+                }
+                // Tasks that have not been handed out yet are skipped once one has failed
+                next_task = task_count;
+            }
+        }
+    };
+
+    // The calling thread works as well, so only thread_count - 1 threads are spawned
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 0; i + 1 < thread_count; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+}
@@ -0,0 +1,175 @@
+#include "core/price_cache.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+using std::ifstream;
+using std::ofstream;
+
+namespace finadvisor {
+
+namespace {
+
+/**
+ * Size and modification time of a file in nanoseconds, or false if the file does not exist. Where the platform only
+ * reports whole seconds, the modification time is still scaled to nanoseconds.
+ */
+bool GetFileStatus(const string& file_path, uint64_t& size, int64_t& modification_time) {
+    struct stat file_status;
+    if (stat(file_path.c_str(), &file_status) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(file_status.st_size);
+#if defined(__APPLE__)
+    modification_time = static_cast<int64_t>(file_status.st_mtimespec.tv_sec) * 1000000000 +
+                        file_status.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    modification_time = static_cast<int64_t>(file_status.st_mtime) * 1000000000;
+#else
+    modification_time = static_cast<int64_t>(file_status.st_mtim.tv_sec) * 1000000000 + file_status.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+/**
+ * Path of a temporary file next to the cache file that no other process or thread writes to at the same time.
+ */
+string GetTemporaryPath(const string& cache_path) {
+    static std::atomic<unsigned long> temporary_file_count(0);
+#ifdef _WIN32
+    long process_id = static_cast<long>(_getpid());
+#else
+    long process_id = static_cast<long>(getpid());
+#endif
+    return cache_path + "." + std::to_string(process_id) + "." + std::to_string(temporary_file_count++) + ".tmp";
+}
+
+}
+
+const char PriceCache::kExtension_[] = ".pricecache";
+const char PriceCache::kMagic_[4] = {'F', 'A', 'P', 'C'};
+
+string PriceCache::GetCachePath(const string& file_path) {
+    return file_path + kExtension_;
+}
+
+uint64_t PriceCache::HashBytes(const void* bytes, size_t length, uint64_t hash) {
+    // 64 bit FNV-1a
+    const unsigned char* byte = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= byte[i];
+        hash *= kHashPrime_;
+    }
+    return hash;
+}
+
+uint64_t PriceCache::HashPayload(const vector<uint32_t>& packed_dates, const PriceSeries& series) {
+    size_t column_size = packed_dates.size() * sizeof(double);
+    uint64_t hash = HashBytes(packed_dates.data(), packed_dates.size() * sizeof(uint32_t), kHashOffsetBasis_);
+    hash = HashBytes(series.opening_prices.data(), column_size, hash);
+    hash = HashBytes(series.high_prices.data(), column_size, hash);
+    hash = HashBytes(series.low_prices.data(), column_size, hash);
+    hash = HashBytes(series.closing_prices.data(), column_size, hash);
+    return HashBytes(series.volumes.data(), column_size, hash);
+}
+
+bool PriceCache::Read(const string& file_path, PriceSeries& series) {
+    uint64_t source_size;
+    int64_t source_modification_time;
+    uint64_t cache_size;
+    int64_t cache_modification_time;
+    if (!GetFileStatus(file_path, source_size, source_modification_time) ||
+        !GetFileStatus(GetCachePath(file_path), cache_size, cache_modification_time) ||
+        cache_modification_time < source_modification_time || cache_size < sizeof(Header)) {
+        return false;
+    }
+
+    ifstream file(GetCachePath(file_path), std::ios::binary);
+    Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(Header)) ||
+        memcmp(header.magic, kMagic_, sizeof(header.magic)) != 0 || header.version != kVersion_ ||
+        header.source_size != source_size || header.source_modification_time != source_modification_time ||
+        cache_size != sizeof(Header) + header.day_count * (sizeof(uint32_t) + 5 * sizeof(double))) {
+        return false;
+    }
+
+    size_t day_count = static_cast<size_t>(header.day_count);
+    size_t column_size = day_count * sizeof(double);
+    vector<uint32_t> packed_dates(day_count);
+    PriceSeries cached_series;
+    cached_series.file_path = file_path;
+    cached_series.opening_prices.resize(day_count);
+    cached_series.high_prices.resize(day_count);
+    cached_series.low_prices.resize(day_count);
+    cached_series.closing_prices.resize(day_count);
+    cached_series.volumes.resize(day_count);
+    file.read(reinterpret_cast<char*>(packed_dates.data()), day_count * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(cached_series.opening_prices.data()), column_size);
+    file.read(reinterpret_cast<char*>(cached_series.high_prices.data()), column_size);
+    file.read(reinterpret_cast<char*>(cached_series.low_prices.data()), column_size);
+    file.read(reinterpret_cast<char*>(cached_series.closing_prices.data()), column_size);
+    file.read(reinterpret_cast<char*>(cached_series.volumes.data()), column_size);
+    if (!file || HashPayload(packed_dates, cached_series) != header.payload_hash) {
+        return false;
+    }
+
+    cached_series.dates.reserve(day_count);
+    for (uint32_t packed_date : packed_dates) {
+        cached_series.dates.emplace_back(Date::FromPackedValue(packed_date));
+    }
+    series = std::move(cached_series);
+    return true;
+}
+
+bool PriceCache::Write(const string& file_path, const PriceSeries& series) {
+    Header header;
+    memcpy(header.magic, kMagic_, sizeof(header.magic));
+    header.version = kVersion_;
+    if (!GetFileStatus(file_path, header.source_size, header.source_modification_time)) {
+        return false;
+    }
+    vector<uint32_t> packed_dates;
+    packed_dates.reserve(series.GetDayCount());
+    for (const Date& date : series.dates) {
+        packed_dates.emplace_back(date.GetPackedValue());
+    }
+    header.day_count = series.GetDayCount();
+    header.payload_hash = HashPayload(packed_dates, series);
+
+    // Written to a temporary file first so a concurrent reader never sees a partially written cache
+    string cache_path = GetCachePath(file_path);
+    string temporary_path = GetTemporaryPath(cache_path);
+    size_t column_size = series.GetDayCount() * sizeof(double);
+    {
+        ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(reinterpret_cast<const char*>(packed_dates.data()), packed_dates.size() * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(series.opening_prices.data()), column_size);
+        file.write(reinterpret_cast<const char*>(series.high_prices.data()), column_size);
+        file.write(reinterpret_cast<const char*>(series.low_prices.data()), column_size);
+        file.write(reinterpret_cast<const char*>(series.closing_prices.data()), column_size);
+        file.write(reinterpret_cast<const char*>(series.volumes.data()), column_size);
+        if (!file) {
+            file.close();
+            std::remove(temporary_path.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(cache_path.c_str());
+#endif
+    if (std::rename(temporary_path.c_str(), cache_path.c_str()) != 0) {
+        std::remove(temporary_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
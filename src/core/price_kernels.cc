@@ -0,0 +1,130 @@
+#include "core/price_kernels.h"
+#include "core/cpu_features.h"
+
+namespace finadvisor {
+
+namespace {
+
+// Halving is exact in binary floating point, so multiplying by 0.5 matches dividing by 2 bit for bit
+const double kHalf = 0.5;
+
+double ComputeQuartilePrice(double opening_price, double closing_price, double high_price, double low_price) {
+    double upper_quartile_average = (closing_price + high_price) / 2;
+    double lower_quartile_average = (low_price + opening_price) / 2;
+    return (upper_quartile_average + lower_quartile_average) / 2;
+}
+
+#ifdef FINADVISOR_HAS_AVX2
+__attribute__((target("avx2")))
+size_t ComputePriceDifferencesAvx2(const double* opening_prices, const double* closing_prices, size_t day_count,
+                                   double* price_differences) {
+    size_t day = 0;
+    for (; day + 4 <= day_count; day += 4) {
+        __m256d opening_price = _mm256_loadu_pd(opening_prices + day);
+        __m256d closing_price = _mm256_loadu_pd(closing_prices + day);
+        _mm256_storeu_pd(price_differences + day, _mm256_sub_pd(opening_price, closing_price));
+    }
+    return day;
+}
+
+__attribute__((target("avx2")))
+size_t ComputeQuartilePricesAvx2(const double* opening_prices, const double* closing_prices,
+                                 const double* high_prices, const double* low_prices, size_t day_count,
+                                 double* quartile_prices) {
+    const __m256d half = _mm256_set1_pd(kHalf);
+    size_t day = 0;
+    for (; day + 4 <= day_count; day += 4) {
+        __m256d upper_quartile_average = _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(closing_prices + day),
+                                                                     _mm256_loadu_pd(high_prices + day)), half);
+        __m256d lower_quartile_average = _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(low_prices + day),
+                                                                     _mm256_loadu_pd(opening_prices + day)), half);
+        _mm256_storeu_pd(quartile_prices + day,
+                         _mm256_mul_pd(_mm256_add_pd(upper_quartile_average, lower_quartile_average), half));
+    }
+    return day;
+}
+#endif
+
+#ifdef FINADVISOR_HAS_SSE2
+size_t ComputePriceDifferencesSse2(const double* opening_prices, const double* closing_prices, size_t day_count,
+                                   double* price_differences) {
+    size_t day = 0;
+    for (; day + 2 <= day_count; day += 2) {
+        __m128d opening_price = _mm_loadu_pd(opening_prices + day);
+        __m128d closing_price = _mm_loadu_pd(closing_prices + day);
+        _mm_storeu_pd(price_differences + day, _mm_sub_pd(opening_price, closing_price));
+    }
+    return day;
+}
+
+size_t ComputeQuartilePricesSse2(const double* opening_prices, const double* closing_prices,
+                                 const double* high_prices, const double* low_prices, size_t day_count,
+                                 double* quartile_prices) {
+    const __m128d half = _mm_set1_pd(kHalf);
+    size_t day = 0;
+    for (; day + 2 <= day_count; day += 2) {
+        __m128d upper_quartile_average = _mm_mul_pd(_mm_add_pd(_mm_loadu_pd(closing_prices + day),
+                                                               _mm_loadu_pd(high_prices + day)), half);
+        __m128d lower_quartile_average = _mm_mul_pd(_mm_add_pd(_mm_loadu_pd(low_prices + day),
+                                                               _mm_loadu_pd(opening_prices + day)), half);
+        _mm_storeu_pd(quartile_prices + day, _mm_mul_pd(_mm_add_pd(upper_quartile_average, lower_quartile_average),
+                                                        half));
+    }
+    return day;
+}
+#endif
+
+}
+
+void ComputePriceDifferences(const double* opening_prices, const double* closing_prices, size_t day_count,
+                             double* price_differences) {
+    size_t day = 0;
+#ifdef FINADVISOR_HAS_AVX2
+    if (SupportsAvx2()) {
+        day = ComputePriceDifferencesAvx2(opening_prices, closing_prices, day_count, price_differences);
+    }
+#endif
+#ifdef FINADVISOR_HAS_SSE2
+    day += ComputePriceDifferencesSse2(opening_prices + day, closing_prices + day, day_count - day,
+                                       price_differences + day);
+#endif
+    // Remaining days are handled one at a time
+    for (; day < day_count; day++) {
+        price_differences[day] = opening_prices[day] - closing_prices[day];
+    }
+}
+
+void ComputeQuartilePrices(const double* opening_prices, const double* closing_prices, const double* high_prices,
+                           const double* low_prices, size_t day_count, double* quartile_prices) {
+    size_t day = 0;
+#ifdef FINADVISOR_HAS_AVX2
+    if (SupportsAvx2()) {
+        day = ComputeQuartilePricesAvx2(opening_prices, closing_prices, high_prices, low_prices, day_count,
+                                        quartile_prices);
+    }
+#endif
+#ifdef FINADVISOR_HAS_SSE2
+    day += ComputeQuartilePricesSse2(opening_prices + day, closing_prices + day, high_prices + day, low_prices + day,
+                                     day_count - day, quartile_prices + day);
+#endif
+    for (; day < day_count; day++) {
+        quartile_prices[day] = ComputeQuartilePrice(opening_prices[day], closing_prices[day], high_prices[day],
+                                                    low_prices[day]);
+    }
+}
+
+vector<double> ComputePriceDifferences(const PriceSeries& series) {
+    vector<double> price_differences(series.GetDayCount());
+    ComputePriceDifferences(series.opening_prices.data(), series.closing_prices.data(), series.GetDayCount(),
+                            price_differences.data());
+    return price_differences;
+}
+
+vector<double> ComputeQuartilePrices(const PriceSeries& series) {
+    vector<double> quartile_prices(series.GetDayCount());
+    ComputeQuartilePrices(series.opening_prices.data(), series.closing_prices.data(), series.high_prices.data(),
+                          series.low_prices.data(), series.GetDayCount(), quartile_prices.data());
+    return quartile_prices;
+}
+
+}
@@ -0,0 +1,80 @@
+#include "core/price_store.h"
+#include "core/mapped_csv_file.h"
+#include "core/price_cache.h"
+#include "core/parallel.h"
+#include <stdexcept>
+
+using std::invalid_argument;
+
+namespace finadvisor {
+
+PriceSeries PriceStore::ParseSeries(const string& file_path) {
+    // Throws invalid argument exception if file cannot be opened
+    MappedCsvFile file(file_path);
+    PriceSeries series;
+    series.file_path = file_path;
+    size_t expected_day_count = file.GetFileSize() / kApproximateLineLength_ + 1;
+    series.dates.reserve(expected_day_count);
+    series.opening_prices.reserve(expected_day_count);
+    series.high_prices.reserve(expected_day_count);
+    series.low_prices.reserve(expected_day_count);
+    series.closing_prices.reserve(expected_day_count);
+    series.volumes.reserve(expected_day_count);
+
+    CsvRow row;
+    while (file.NextRow(row)) {
+        series.dates.emplace_back(row.GetDate(kDateIndex_));
+        series.opening_prices.emplace_back(row.GetDouble(kOpeningPriceIndex_));
+        series.high_prices.emplace_back(row.GetDouble(kHighPriceIndex_));
+        series.low_prices.emplace_back(row.GetDouble(kLowPriceIndex_));
+        series.closing_prices.emplace_back(row.GetDouble(kClosingPriceIndex_));
+        // Volume column is optional
+        series.volumes.emplace_back(row.GetColumnCount() > kVolumeIndex_ ? row.GetDouble(kVolumeIndex_) : 0.0);
+    }
+    return series;
+}
+
+PriceSeries PriceStore::LoadSeries(const string& file_path) const {
+    PriceSeries series;
+    if (use_binary_cache_ && PriceCache::Read(file_path, series)) {
+        return series;
+    }
+    series = ParseSeries(file_path);
+    if (use_binary_cache_) {
+        PriceCache::Write(file_path, series);
+    }
+    return series;
+}
+
+void PriceStore::SetUseBinaryCache(bool use_binary_cache) {
+    use_binary_cache_ = use_binary_cache;
+}
+
+void PriceStore::SetThreadCount(size_t thread_count) {
+    thread_count_ = thread_count;
+}
+
+PriceStore PriceStore::ValidateFiles(const vector<string>& file_paths) const {
+    PriceStore store;
+    store.use_binary_cache_ = use_binary_cache_;
+    store.thread_count_ = thread_count_;
+    // Every series is written to its own slot, so the order of series always matches the order of file paths
+    store.series_.resize(file_paths.size());
+    ParallelFor(file_paths.size(), thread_count_, [&](size_t file_index) {
+        store.series_[file_index] = LoadSeries(file_paths[file_index]);
+    });
+    return store;
+}
+
+size_t PriceStore::GetSeriesCount() const {
+    return series_.size();
+}
+
+const PriceSeries& PriceStore::GetSeries(size_t series_index) const {
+    if (series_index >= series_.size()) {
+        throw invalid_argument("Index out of bounds");
+    }
+    return series_[series_index];
+}
+
+}
@@ -0,0 +1,202 @@
+#include "core/rolling_window.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using std::invalid_argument;
+
+namespace finadvisor {
+
+RollingWindow::RollingWindow(size_t window_length) : values_(window_length), window_length_(window_length) {
+    if (window_length == 0) {
+        throw invalid_argument("Window length must be positive");
+    }
+}
+
+void RollingWindow::Add(double value) {
+    if (window_length_ == 0) {
+        throw invalid_argument("Window length must be positive");
+    }
+    bool repeats_newest_value = day_count_ > 0 &&
+            value == values_[(oldest_position_ + day_count_ - 1) % window_length_];
+    if (repeats_newest_value && day_count_ == window_length_ && equal_value_count_ >= window_length_) {
+        // Sliding a window of equal values along by that same value leaves every statistic as it was, so flat
+        // series skip the exact slope recomputation below
+        oldest_position_ = (oldest_position_ + 1) % window_length_;
+        return;
+    }
+    equal_value_count_ = repeats_newest_value ? std::min(equal_value_count_ + 1, window_length_) : 1;
+
+    if (day_count_ == window_length_) {
+        RemoveStatistics(values_[oldest_position_]);
+        values_[oldest_position_] = value;
+        oldest_position_ = (oldest_position_ + 1) % window_length_;
+    } else {
+        values_[(oldest_position_ + day_count_) % window_length_] = value;
+    }
+    AddStatistics(value);
+
+    if (++days_since_synchronization_ >= window_length_) {
+        Synchronize();
+    } else if (positive_count_ == 0 && negative_count_ == 0) {
+        // Every value in window is 0, so flat windows are identified exactly as a recomputation would
+        shifted_sum_ = -reference_ * day_count_;
+        mean_ = 0.0;
+        squared_deviation_sum_ = 0.0;
+        slope_numerator_ = 0.0;
+    } else if (std::fabs(slope_numerator_) <=
+               kSlopeRoundingTolerance_ * day_count_ * day_count_ * shifted_absolute_sum_) {
+        // The sign of the slope decides the momentum category, so a slope within rounding error of 0 is recomputed
+        SynchronizeSlopeNumerator();
+    }
+}
+
+void RollingWindow::SynchronizeSlopeNumerator() {
+    double average = 0.0;
+    slope_numerator_ = 0.0;
+    for (size_t day = 0; day < day_count_; day++) {
+        double value = values_[(oldest_position_ + day) % window_length_];
+        average += (value - average) / static_cast<double>(day + 1);
+        slope_numerator_ += (static_cast<double>(day + 1) / 2) * (value - average);
+    }
+}
+
+void RollingWindow::AddStatistics(double value) {
+    double shifted_value = value - reference_;
+    // Appending day n + 1 moves the average day count up by 1/2
+    slope_numerator_ += -shifted_sum_ / 2 + (static_cast<double>(day_count_) / 2) * shifted_value;
+    shifted_sum_ += shifted_value;
+    shifted_absolute_sum_ += std::fabs(shifted_value);
+    day_count_++;
+
+    double deviation = value - mean_;
+    mean_ += deviation / day_count_;
+    squared_deviation_sum_ += deviation * (value - mean_);
+
+    if (value > 0) {
+        total_gain_ += value;
+        positive_count_++;
+    } else if (value < 0) {
+        total_loss_ += value;
+        negative_count_++;
+    }
+}
+
+void RollingWindow::RemoveStatistics(double value) {
+    double shifted_value = value - reference_;
+    // Dropping day 1 moves every remaining day count down by 1
+    slope_numerator_ += (static_cast<double>(day_count_) / 2) * shifted_value - shifted_sum_ / 2;
+    shifted_sum_ -= shifted_value;
+    shifted_absolute_sum_ -= std::fabs(shifted_value);
+    day_count_--;
+
+    if (day_count_ == 0) {
+        mean_ = 0.0;
+        squared_deviation_sum_ = 0.0;
+    } else {
+        double deviation = value - mean_;
+        mean_ -= deviation / day_count_;
+        squared_deviation_sum_ -= deviation * (value - mean_);
+        if (squared_deviation_sum_ < 0) {
+            squared_deviation_sum_ = 0.0;
+        }
+    }
+
+    if (value > 0) {
+        total_gain_ -= value;
+        positive_count_--;
+    } else if (value < 0) {
+        total_loss_ -= value;
+        negative_count_--;
+    }
+    // Keeps empty totals exactly 0 so they match a recomputation
+    if (positive_count_ == 0) {
+        total_gain_ = 0.0;
+    }
+    if (negative_count_ == 0) {
+        total_loss_ = 0.0;
+    }
+}
+
+void RollingWindow::Synchronize() {
+    days_since_synchronization_ = 0;
+    size_t day_count = day_count_;
+    double sum = 0.0;
+    for (size_t day = 0; day < day_count; day++) {
+        sum += values_[(oldest_position_ + day) % window_length_];
+    }
+    reference_ = day_count > 0 ? sum / day_count : 0.0;
+    mean_ = reference_;
+
+    shifted_sum_ = 0.0;
+    shifted_absolute_sum_ = 0.0;
+    squared_deviation_sum_ = 0.0;
+    total_gain_ = 0.0;
+    total_loss_ = 0.0;
+    positive_count_ = 0;
+    negative_count_ = 0;
+    for (size_t day = 0; day < day_count; day++) {
+        double value = values_[(oldest_position_ + day) % window_length_];
+        double shifted_value = value - reference_;
+        shifted_sum_ += shifted_value;
+        shifted_absolute_sum_ += std::fabs(shifted_value);
+        squared_deviation_sum_ += shifted_value * shifted_value;
+        if (value > 0) {
+            total_gain_ += value;
+            positive_count_++;
+        } else if (value < 0) {
+            total_loss_ += value;
+            negative_count_++;
+        }
+    }
+    SynchronizeSlopeNumerator();
+}
+
+void RollingWindow::Clear() {
+    size_t window_length = window_length_;
+    *this = RollingWindow();
+    window_length_ = window_length;
+    values_.resize(window_length);
+}
+
+bool RollingWindow::IsFull() const {
+    return window_length_ > 0 && day_count_ == window_length_;
+}
+
+size_t RollingWindow::GetWindowLength() const {
+    return window_length_;
+}
+
+size_t RollingWindow::GetDayCount() const {
+    return day_count_;
+}
+
+double RollingWindow::GetMean() const {
+    return mean_;
+}
+
+double RollingWindow::GetSquaredDeviationSum() const {
+    return squared_deviation_sum_;
+}
+
+double RollingWindow::GetSlopeNumerator() const {
+    return slope_numerator_;
+}
+
+double RollingWindow::GetTotalGain() const {
+    return total_gain_;
+}
+
+double RollingWindow::GetTotalLoss() const {
+    return total_loss_;
+}
+
+size_t RollingWindow::GetPositiveCount() const {
+    return positive_count_;
+}
+
+size_t RollingWindow::GetNegativeCount() const {
+    return negative_count_;
+}
+
+}
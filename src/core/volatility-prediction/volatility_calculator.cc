@@ -1,25 +1,13 @@
 #include "core/volatility-prediction/volatility_calculator.h"
 #include "core/momentum-prediction/momentum_calculator.h"
 #include <cmath>
-#include <numeric>
-#include <iostream>
-
-using std::transform;
-using std::accumulate;
+#include <stdexcept>
 
 namespace finadvisor {
 
 vector<double> VolatilityCalculator::StandardizeQuartilePrices(const vector<double>& quartile_prices) const {
-    vector<double> standardized_quartile_prices;
-    standardized_quartile_prices.reserve(quartile_prices.size());
-    // Z-score = (observed value - mean) / standard deviation
-    double mean = accumulate(quartile_prices.begin(), quartile_prices.end(), 0.0) /
-                  quartile_prices.size();
-    double standard_deviation = sqrt((inner_product(quartile_prices.begin(), quartile_prices.end(),
-                                                    quartile_prices.begin(), 0.0) / quartile_prices.size()) - pow(mean, 2));
-    for (double quartile_price : quartile_prices) {
-        standardized_quartile_prices.emplace_back((quartile_price - mean) / standard_deviation);
-    }
+    vector<double> standardized_quartile_prices(quartile_prices.size());
+    ComputeVolatilityStatistics(quartile_prices.data(), quartile_prices.size(), standardized_quartile_prices.data());
     return standardized_quartile_prices;
 }
 
@@ -32,52 +20,106 @@ double VolatilityCalculator::CalculateQuartilePrice(double opening_price, double
     return (upper_quartile_average + lower_quartile_average) / 2;
 }
 
-double VolatilityCalculator::ComputeBetaRiskProportion(const vector<double>& quartile_prices, double price_variance) const {
-    if (quartile_prices.empty() || price_variance == 0) {
+double VolatilityCalculator::ScaleBetaRiskProportion(double linear_regression_slope, double price_variance,
+                                                     size_t day_count) const {
+    if (day_count == 0 || price_variance == 0) {
         return 0;
     }
     // Slope of linear regression is the covariance divided by variance of an independent variable.
     // So, covariance = linear regression slope * variance
-    MomentumCalculator calculator;
-    double price_covariance = calculator.ComputeLinearRegressionSlope(quartile_prices) * price_variance;
+    double price_covariance = linear_regression_slope * price_variance;
     // Ignore denominator in conventional beta risk formula as the variance is standardized during computation of
     // linear regression slope.
-    return sqrt((1 / static_cast<double>(quartile_prices.size())) * price_variance) * price_covariance;
+    return sqrt((1 / static_cast<double>(day_count)) * price_variance) * price_covariance;
+}
+
+double VolatilityCalculator::ComputeBetaRiskProportion(const vector<double>& quartile_prices, double price_variance) const {
+    if (quartile_prices.empty() || price_variance == 0) {
+        return 0;
+    }
+    MomentumCalculator calculator;
+    return ScaleBetaRiskProportion(calculator.ComputeLinearRegressionSlope(quartile_prices), price_variance,
+                                   quartile_prices.size());
 }
 
 double VolatilityCalculator::CalculatePriceVariance(const vector<double>& quartile_prices) const {
-    vector<double> quartile_price_deviations;
-    quartile_price_deviations.reserve(quartile_prices.size());
-    double quartile_price_average = 0;
+    return ComputeVolatilityStatistics(quartile_prices.data(), quartile_prices.size(), nullptr).price_variance;
+}
+
+VolatilityStatistics VolatilityCalculator::ComputeVolatilityStatistics(const double* quartile_prices, size_t day_count,
+                                                                       double* standardized_quartile_prices) const {
+    // Prices are shifted by the first one so running sums stay small in magnitude for prices far from 0
+    double reference = day_count > 0 ? quartile_prices[0] : 0.0;
+    double shifted_mean = 0.0;
+    double price_variance = 0.0;
+    double slope_numerator = 0.0;
+    for (size_t i = 0; i < day_count; i++) {
+        double shifted_price = quartile_prices[i] - reference;
+        double deviation = shifted_price - shifted_mean;
+        shifted_mean += deviation / static_cast<double>(i + 1);
+        price_variance += deviation * (shifted_price - shifted_mean);
+        // Co-moment of day counts and prices centered on their running means, as MomentumCalculator computes it. Day
+        // i + 1 lies (i + 1) / 2 past the average of the days before.
+        slope_numerator += (static_cast<double>(i + 1) / 2) * (shifted_price - shifted_mean);
+    }
 
-    for (double quartile_price : quartile_prices) {
-        quartile_price_deviations.emplace_back(quartile_price);
-        quartile_price_average += quartile_price;
+    VolatilityStatistics statistics;
+    statistics.price_variance = price_variance;
+    statistics.beta_risk_proportion = 0;
+    if (day_count > 0 && price_variance != 0) {
+        MomentumCalculator calculator;
+        statistics.beta_risk_proportion = ScaleBetaRiskProportion(
+                slope_numerator / calculator.ComputeDayCountDeviation(day_count), price_variance, day_count);
     }
-    quartile_price_average /= quartile_price_deviations.size();
-    // Subtract quartile price average from each element of vector and then square each element
-    transform(quartile_price_deviations.begin(), quartile_price_deviations.end(), quartile_price_deviations.begin(),
-              [&](double quartile_price) { return pow(quartile_price - quartile_price_average, 2); });
-    // Return sum of price deviations
-    return accumulate(quartile_price_deviations.begin(), quartile_price_deviations.end(), 0.0);
+    statistics.volatility = ClassifyVolatility(price_variance, statistics.beta_risk_proportion, day_count);
+
+    if (standardized_quartile_prices != nullptr) {
+        // Z-score = (observed value - mean) / standard deviation
+        double standard_deviation = sqrt(price_variance / day_count);
+        for (size_t i = 0; i < day_count; i++) {
+            standardized_quartile_prices[i] = (quartile_prices[i] - reference - shifted_mean) / standard_deviation;
+        }
+    }
+    return statistics;
 }
 
-Volatility VolatilityCalculator::IdentifyVolatility(const vector<double>& quartile_prices) {
+vector<VolatilityStatistics> VolatilityCalculator::ComputeVolatilityStatistics(
+        const vector<double>& quartile_prices, const vector<size_t>& window_bounds,
+        vector<double>& standardized_quartile_prices) const {
+    vector<VolatilityStatistics> statistics;
+    standardized_quartile_prices.resize(quartile_prices.size());
+    if (window_bounds.empty()) {
+        return statistics;
+    }
+    statistics.reserve(window_bounds.size() - 1);
+    for (size_t window = 0; window + 1 < window_bounds.size(); window++) {
+        if (window_bounds[window] > window_bounds[window + 1] || window_bounds[window + 1] > quartile_prices.size()) {
+            throw std::invalid_argument("Index out of bounds");
+        }
+        size_t first_day = window_bounds[window];
+        statistics.emplace_back(ComputeVolatilityStatistics(quartile_prices.data() + first_day,
+                                                            window_bounds[window + 1] - first_day,
+                                                            standardized_quartile_prices.data() + first_day));
+    }
+    return statistics;
+}
+
+Volatility VolatilityCalculator::ClassifyVolatility(double price_variance, double beta_risk_proportion,
+                                                    size_t day_count) const {
     Volatility volatility;
-    // Note: The use of volatility index below cannot be confounded with the CBOE volatility index
-    double volatility_index = CalculatePriceVariance(quartile_prices);
     // Beta risk proportion is an indicator of the volatility's ability to predict the future dispersion of market
     // returns or securities or to reflect the past dispersion.
-    if (abs(ComputeBetaRiskProportion(quartile_prices, volatility_index)) >= kHalfProportion_) {
+    if (abs(beta_risk_proportion) >= kHalfProportion_) {
         volatility.category = VolatilityCategory::Implied;
     } else {
         volatility.category = VolatilityCategory::Historical;
     }
 
-    volatility_index /= quartile_prices.size();
-    if (volatility_index >= (kTwoThirdsProportion_ * quartile_prices.size())) {
+    // Note: The use of volatility index below cannot be confounded with the CBOE volatility index
+    double volatility_index = price_variance / day_count;
+    if (volatility_index >= (kTwoThirdsProportion_ * day_count)) {
         volatility.measure = VolatilityMeasure::High;
-    } else if (volatility_index >= (kOneThirdsProportion_) * quartile_prices.size()) {
+    } else if (volatility_index >= (kOneThirdsProportion_) * day_count) {
         volatility.measure = VolatilityMeasure::Medium;
     } else {
         volatility.measure = VolatilityMeasure::Low;
@@ -85,4 +127,19 @@ Volatility VolatilityCalculator::IdentifyVolatility(const vector<double>& quarti
     return volatility;
 }
 
+Volatility VolatilityCalculator::IdentifyVolatility(const vector<double>& quartile_prices) {
+    return ComputeVolatilityStatistics(quartile_prices.data(), quartile_prices.size(), nullptr).volatility;
+}
+
+Volatility VolatilityCalculator::IdentifyVolatility(const RollingWindow& window) {
+    double price_variance = window.GetSquaredDeviationSum();
+    double beta_risk_proportion = 0;
+    if (window.GetDayCount() > 0 && price_variance != 0) {
+        MomentumCalculator calculator;
+        double linear_regression_slope = calculator.ComputeMomentumStatistics(window).linear_regression_slope;
+        beta_risk_proportion = ScaleBetaRiskProportion(linear_regression_slope, price_variance, window.GetDayCount());
+    }
+    return ClassifyVolatility(price_variance, beta_risk_proportion, window.GetDayCount());
+}
+
 }
@@ -1,8 +1,10 @@
 #include "core/volatility-prediction/volatility_classifier.h"
 #include "core/data_processor.h"
-#include <float.h>
+#include "core/parallel.h"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <numeric>
 
 using std::ifstream;
 using std::invalid_argument;
@@ -15,7 +17,7 @@ VolatilityPoint VolatilityClassifier::GetVolatilityTestingPoint(size_t vector_in
 
 istream &operator>>(istream &input, VolatilityClassifier &classifier) {
     DataProcessor processor;
-    VolatilityPoint point;
+    VolatilityPoint point = {kNoLabel_, 0, 0};
     std::string line;
     while (getline(input, line)) {
         if (!std::isalpha(line[0])) {
@@ -25,7 +27,7 @@ istream &operator>>(istream &input, VolatilityClassifier &classifier) {
             classifier.volatility_testing_points_.reserve(classifier.volatility_testing_points_.size() + 1);
             classifier.volatility_testing_points_.emplace_back(point);
         } else {
-            point.volatility_type = line;
+            point.volatility_type = ParseVolatilityType(line);
         }
     }
     return input;
@@ -45,28 +47,26 @@ VolatilityClassifier VolatilityClassifier::ValidateFile(const std::string &file_
     }
 }
 
-double VolatilityClassifier::CalculateValidationAccuracy(VolatilityModel model, size_t cluster_size) {
-    double validation_accuracy = 0;
-    for (const VolatilityPoint &point : volatility_testing_points_) {
-        model.AssignClusterPoints(cluster_size);
-        model.UpdateCentroidData();
-        double min_probability_difference = DBL_MAX;
-        string cluster_trend;
-        for (size_t i = 0; i < model.GetClusterCount(); i++) {
-            double probability_difference = abs(model.GetCluster(i).positive_z_score_probability -
-                                                model.GetCluster(i).positive_z_score_probability) +
-                                            abs(model.GetCluster(i).negative_z_score_probability -
-                                                model.GetCluster(i).negative_z_score_probability);
-            if (probability_difference < min_probability_difference) {
-                min_probability_difference = probability_difference;
-                cluster_trend = model.GetCluster(i).volatility_type;
-            }
-            if (cluster_trend == point.volatility_type) {
-                validation_accuracy++;
+double VolatilityClassifier::CalculateValidationAccuracy(const VolatilityModel& model) const {
+    size_t batch_count = (volatility_testing_points_.size() + kBatchSize_ - 1) / kBatchSize_;
+    vector<size_t> correct_counts(batch_count);
+    ParallelFor(batch_count, thread_count_, [&](size_t batch) {
+        size_t end = std::min(volatility_testing_points_.size(), (batch + 1) * kBatchSize_);
+        for (size_t i = batch * kBatchSize_; i < end; i++) {
+            const VolatilityPoint& point = volatility_testing_points_[i];
+            if (model.ClassifyVolatilityPoint(point.positive_z_score_probability,
+                                              point.negative_z_score_probability) == point.volatility_type) {
+                correct_counts[batch]++;
             }
         }
-    }
+    });
+
+    double validation_accuracy = std::accumulate(correct_counts.begin(), correct_counts.end(), size_t(0));
     return validation_accuracy / volatility_testing_points_.size();
 }
 
-}
\ No newline at end of file
+void VolatilityClassifier::SetThreadCount(size_t thread_count) {
+    thread_count_ = thread_count;
+}
+
+}
@@ -0,0 +1,510 @@
+#include "core/volatility-prediction/volatility_clustering.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+#include <numeric>
+
+namespace finadvisor {
+
+namespace {
+
+// Volatility points handled by one task; chunk boundaries also fix the order centroid sums are reduced in
+const size_t kChunkSize = 4096;
+
+// Distance from their common line, relative to the spread of volatility points, under which points count as collinear
+const double kCollinearityTolerance = 1e-9;
+// Relative slack on distance bounds, far above the rounding error accumulated by updating them, so a volatility point
+// keeps its cluster unchecked only when that cluster is nearest by a clear margin
+const double kBoundMargin = 1e-9;
+
+/**
+ * Nearest and second nearest clusters of a volatility point.
+ */
+struct NearestClusters {
+    size_t cluster_id;
+    double squared_distance;
+    double second_squared_distance;
+};
+
+/**
+ * Weighted prefix sums over groups of equal positions along a line, sorted by position. Positions are taken relative
+ * to their mean, which keeps the sums of squares from cancelling.
+ */
+struct LinePrefixSums {
+    vector<double> weights;
+    vector<double> sums;
+    vector<double> squared_sums;
+
+    /**
+     * Computes inertia along the line of groups from begin up to but not including end.
+     */
+    double ComputeCost(size_t begin, size_t end) const {
+        double sum = sums[end] - sums[begin];
+        double cost = squared_sums[end] - squared_sums[begin] - sum * sum / (weights[end] - weights[begin]);
+        return std::max(cost, 0.0);
+    }
+};
+
+size_t GetChunkCount(size_t point_count) {
+    return (point_count + kChunkSize - 1) / kChunkSize;
+}
+
+/**
+ * Computes squared distance from a volatility point to a cluster the same way for every clustering method, so that
+ * methods agree on assignments bit for bit.
+ */
+double ComputeSquaredDistance(double x_coordinate, double y_coordinate, const VolatilityPoint& cluster) {
+    double x_difference = x_coordinate - cluster.positive_z_score_probability;
+    double y_difference = y_coordinate - cluster.negative_z_score_probability;
+    return x_difference * x_difference + y_difference * y_difference;
+}
+
+NearestClusters FindNearestClusters(double x_coordinate, double y_coordinate,
+                                    const vector<VolatilityPoint>& clusters) {
+    NearestClusters nearest_clusters = {0, DBL_MAX, DBL_MAX};
+    for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+        double distance = ComputeSquaredDistance(x_coordinate, y_coordinate, clusters[cluster_id]);
+        if (distance < nearest_clusters.squared_distance) {
+            nearest_clusters.second_squared_distance = nearest_clusters.squared_distance;
+            nearest_clusters.squared_distance = distance;
+            nearest_clusters.cluster_id = cluster_id;
+        } else if (distance < nearest_clusters.second_squared_distance) {
+            nearest_clusters.second_squared_distance = distance;
+        }
+    }
+    return nearest_clusters;
+}
+
+/**
+ * Computes every lowest cost of splitting groups up to an end into one more cluster, for ends from first_end to
+ * last_end, by divide and conquer. The best split never moves left as the end moves right, so each half of the ends
+ * only searches the splits on its side of the split found for the middle end.
+ */
+void FillCostLayer(const LinePrefixSums& prefix_sums, const vector<double>& previous_costs, size_t first_end,
+                   size_t last_end, size_t first_split, size_t last_split, vector<double>& costs, size_t* splits) {
+    size_t end = first_end + (last_end - first_end) / 2;
+    double minimum_cost = DBL_MAX;
+    size_t best_split = first_split;
+    for (size_t split = first_split; split <= std::min(last_split, end - 1); split++) {
+        double cost = previous_costs[split] + prefix_sums.ComputeCost(split, end);
+        if (cost < minimum_cost) {
+            minimum_cost = cost;
+            best_split = split;
+        }
+    }
+    costs[end] = minimum_cost;
+    splits[end] = best_split;
+    if (end > first_end) {
+        FillCostLayer(prefix_sums, previous_costs, first_end, end - 1, first_split, best_split, costs, splits);
+    }
+    if (end < last_end) {
+        FillCostLayer(prefix_sums, previous_costs, end + 1, last_end, best_split, last_split, costs, splits);
+    }
+}
+
+void ComputeAssignedDistances(const VolatilityPointArrays& points, const vector<VolatilityPoint>& clusters,
+                              const vector<size_t>& point_clusters, size_t thread_count,
+                              vector<double>& minimum_distances) {
+    minimum_distances.resize(points.point_count);
+    ParallelFor(GetChunkCount(points.point_count), thread_count, [&](size_t chunk) {
+        size_t end = std::min(points.point_count, (chunk + 1) * kChunkSize);
+        for (size_t point = chunk * kChunkSize; point < end; point++) {
+            minimum_distances[point] = ComputeSquaredDistance(points.x_coordinates[point], points.y_coordinates[point],
+                                                              clusters[point_clusters[point]]);
+        }
+    });
+}
+
+}
+
+void SeedKMeansPlusPlus(const VolatilityPointArrays& points, size_t cluster_count, std::mt19937_64& generator,
+                        vector<VolatilityPoint>& clusters, vector<double>& minimum_distances) {
+    clusters.clear();
+    minimum_distances.assign(points.point_count, DBL_MAX);
+    if (points.point_count == 0 || cluster_count == 0) {
+        return;
+    }
+    clusters.reserve(cluster_count);
+
+    // Before any cluster is drawn every volatility point counts by weight alone
+    double total_weight = 0;
+    for (size_t point = 0; point < points.point_count; point++) {
+        total_weight += static_cast<double>(points.weights[point]);
+    }
+    std::uniform_real_distribution<double> distribution(0, 1);
+    size_t drawn_point = 0;
+    double threshold = distribution(generator) * total_weight;
+    for (double cumulative_weight = 0; drawn_point + 1 < points.point_count; drawn_point++) {
+        cumulative_weight += static_cast<double>(points.weights[drawn_point]);
+        if (threshold < cumulative_weight) {
+            break;
+        }
+    }
+
+    while (true) {
+        clusters.push_back({kNoLabel_, points.x_coordinates[drawn_point], points.y_coordinates[drawn_point]});
+        double total_distance = 0;
+        for (size_t point = 0; point < points.point_count; point++) {
+            double x_difference = points.x_coordinates[point] - points.x_coordinates[drawn_point];
+            double y_difference = points.y_coordinates[point] - points.y_coordinates[drawn_point];
+            minimum_distances[point] = std::min(minimum_distances[point],
+                                                x_difference * x_difference + y_difference * y_difference);
+            total_distance += static_cast<double>(points.weights[point]) * minimum_distances[point];
+        }
+        // Every volatility point already lies on a cluster
+        if (clusters.size() == cluster_count || total_distance == 0) {
+            break;
+        }
+
+        threshold = distribution(generator) * total_distance;
+        double cumulative_distance = 0;
+        for (size_t point = 0; point < points.point_count; point++) {
+            if (minimum_distances[point] == 0) {
+                continue;
+            }
+            // Rounding may leave the threshold past the last sum, in which case the last candidate is drawn
+            drawn_point = point;
+            cumulative_distance += static_cast<double>(points.weights[point]) * minimum_distances[point];
+            if (threshold < cumulative_distance) {
+                break;
+            }
+        }
+    }
+}
+
+size_t AssignNearestClusters(const VolatilityPointArrays& points, const vector<VolatilityPoint>& clusters,
+                             size_t thread_count, vector<size_t>& point_clusters, vector<double>& minimum_distances) {
+    point_clusters.resize(points.point_count);
+    minimum_distances.resize(points.point_count);
+    size_t chunk_count = GetChunkCount(points.point_count);
+    vector<size_t> change_counts(chunk_count);
+    ParallelFor(chunk_count, thread_count, [&](size_t chunk) {
+        size_t end = std::min(points.point_count, (chunk + 1) * kChunkSize);
+        for (size_t point = chunk * kChunkSize; point < end; point++) {
+            double minimum_distance = DBL_MAX;
+            size_t nearest_cluster = 0;
+            for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+                double distance = ComputeSquaredDistance(points.x_coordinates[point], points.y_coordinates[point],
+                                                         clusters[cluster_id]);
+                if (distance < minimum_distance) {
+                    minimum_distance = distance;
+                    nearest_cluster = cluster_id;
+                }
+            }
+            if (point_clusters[point] != nearest_cluster) {
+                point_clusters[point] = nearest_cluster;
+                change_counts[chunk]++;
+            }
+            minimum_distances[point] = minimum_distance;
+        }
+    });
+
+    size_t change_count = 0;
+    for (size_t chunk_change_count : change_counts) {
+        change_count += chunk_change_count;
+    }
+    return change_count;
+}
+
+void SumCentroids(const VolatilityPointArrays& points, const vector<size_t>& point_clusters, size_t cluster_count,
+                  size_t thread_count, vector<Centroid>& centroids) {
+    size_t chunk_count = GetChunkCount(points.point_count);
+    // Centroids of each chunk, one slot per cluster
+    vector<Centroid> chunk_centroids(chunk_count * cluster_count, Centroid{0, 0, 0});
+    ParallelFor(chunk_count, thread_count, [&](size_t chunk) {
+        Centroid* partial_centroids = chunk_centroids.data() + chunk * cluster_count;
+        size_t end = std::min(points.point_count, (chunk + 1) * kChunkSize);
+        for (size_t point = chunk * kChunkSize; point < end; point++) {
+            Centroid& centroid = partial_centroids[point_clusters[point]];
+            double weight = static_cast<double>(points.weights[point]);
+            centroid.point_count += points.weights[point];
+            centroid.x_coordinate_sum += weight * points.x_coordinates[point];
+            centroid.y_coordinate_sum += weight * points.y_coordinates[point];
+        }
+    });
+
+    centroids.assign(cluster_count, Centroid{0, 0, 0});
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+        for (size_t cluster_id = 0; cluster_id < cluster_count; cluster_id++) {
+            const Centroid& partial_centroid = chunk_centroids[chunk * cluster_count + cluster_id];
+            centroids[cluster_id].point_count += partial_centroid.point_count;
+            centroids[cluster_id].x_coordinate_sum += partial_centroid.x_coordinate_sum;
+            centroids[cluster_id].y_coordinate_sum += partial_centroid.y_coordinate_sum;
+        }
+    }
+}
+
+void MoveClustersToCentroids(const vector<Centroid>& centroids, vector<VolatilityPoint>& clusters) {
+    for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+        if (centroids[cluster_id].point_count != 0) {
+            clusters[cluster_id].positive_z_score_probability = centroids[cluster_id].x_coordinate_sum /
+                    centroids[cluster_id].point_count;
+            clusters[cluster_id].negative_z_score_probability = centroids[cluster_id].y_coordinate_sum /
+                    centroids[cluster_id].point_count;
+        }
+    }
+}
+
+ClusteringReport RunLloydKMeans(const VolatilityPointArrays& points, size_t maximum_iteration_count,
+                                size_t thread_count, vector<VolatilityPoint>& clusters, vector<Centroid>& centroids,
+                                vector<size_t>& point_clusters, vector<double>& minimum_distances) {
+    ClusteringReport report = {0, 0, false};
+    AssignNearestClusters(points, clusters, thread_count, point_clusters, minimum_distances);
+    SumCentroids(points, point_clusters, clusters.size(), thread_count, centroids);
+    while (report.iteration_count < maximum_iteration_count) {
+        MoveClustersToCentroids(centroids, clusters);
+        size_t change_count = AssignNearestClusters(points, clusters, thread_count, point_clusters,
+                                                    minimum_distances);
+        report.iteration_count++;
+        if (change_count == 0) {
+            // Centroids already match the unchanged assignment
+            report.converged = true;
+            break;
+        }
+        SumCentroids(points, point_clusters, clusters.size(), thread_count, centroids);
+    }
+    if (!report.converged) {
+        // The iteration cap stopped the run after summing centroids, so clusters have yet to move onto them
+        MoveClustersToCentroids(centroids, clusters);
+        ComputeAssignedDistances(points, clusters, point_clusters, thread_count, minimum_distances);
+    }
+    report.inertia = ComputeInertia(points, minimum_distances);
+    return report;
+}
+
+ClusteringReport RunHamerlyKMeans(const VolatilityPointArrays& points, size_t maximum_iteration_count,
+                                  size_t thread_count, vector<VolatilityPoint>& clusters, vector<Centroid>& centroids,
+                                  vector<size_t>& point_clusters, vector<double>& minimum_distances) {
+    ClusteringReport report = {0, 0, false};
+    size_t chunk_count = GetChunkCount(points.point_count);
+    // Distance to the cluster assigned is at most the upper bound, and to every other cluster at least the lower bound
+    vector<double> upper_bounds(points.point_count);
+    vector<double> lower_bounds(points.point_count);
+    point_clusters.resize(points.point_count);
+    ParallelFor(chunk_count, thread_count, [&](size_t chunk) {
+        size_t end = std::min(points.point_count, (chunk + 1) * kChunkSize);
+        for (size_t point = chunk * kChunkSize; point < end; point++) {
+            NearestClusters nearest_clusters = FindNearestClusters(points.x_coordinates[point],
+                                                                   points.y_coordinates[point], clusters);
+            point_clusters[point] = nearest_clusters.cluster_id;
+            upper_bounds[point] = sqrt(nearest_clusters.squared_distance);
+            lower_bounds[point] = sqrt(nearest_clusters.second_squared_distance);
+        }
+    });
+    SumCentroids(points, point_clusters, clusters.size(), thread_count, centroids);
+
+    vector<VolatilityPoint> previous_clusters;
+    vector<double> drifts(clusters.size());
+    vector<double> half_separations(clusters.size());
+    vector<size_t> change_counts(chunk_count);
+    while (report.iteration_count < maximum_iteration_count) {
+        previous_clusters = clusters;
+        MoveClustersToCentroids(centroids, clusters);
+        double maximum_drift = 0;
+        for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+            drifts[cluster_id] = sqrt(ComputeSquaredDistance(previous_clusters[cluster_id].positive_z_score_probability,
+                                                             previous_clusters[cluster_id].negative_z_score_probability,
+                                                             clusters[cluster_id]));
+            maximum_drift = std::max(maximum_drift, drifts[cluster_id]);
+        }
+        // A volatility point closer to its cluster than half the distance to any other cluster cannot change cluster
+        for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+            double minimum_separation = DBL_MAX;
+            for (size_t other_cluster_id = 0; other_cluster_id < clusters.size(); other_cluster_id++) {
+                if (other_cluster_id != cluster_id) {
+                    minimum_separation = std::min(minimum_separation, ComputeSquaredDistance(
+                            clusters[cluster_id].positive_z_score_probability,
+                            clusters[cluster_id].negative_z_score_probability, clusters[other_cluster_id]));
+                }
+            }
+            half_separations[cluster_id] = sqrt(minimum_separation) / 2;
+        }
+
+        std::fill(change_counts.begin(), change_counts.end(), 0);
+        ParallelFor(chunk_count, thread_count, [&](size_t chunk) {
+            size_t end = std::min(points.point_count, (chunk + 1) * kChunkSize);
+            for (size_t point = chunk * kChunkSize; point < end; point++) {
+                size_t cluster_id = point_clusters[point];
+                upper_bounds[point] += drifts[cluster_id];
+                lower_bounds[point] -= maximum_drift;
+                double bound = std::max(half_separations[cluster_id], lower_bounds[point]);
+                if (upper_bounds[point] * (1 + kBoundMargin) < bound) {
+                    continue;
+                }
+                upper_bounds[point] = sqrt(ComputeSquaredDistance(points.x_coordinates[point],
+                                                                  points.y_coordinates[point], clusters[cluster_id]));
+                if (upper_bounds[point] * (1 + kBoundMargin) < bound) {
+                    continue;
+                }
+                NearestClusters nearest_clusters = FindNearestClusters(points.x_coordinates[point],
+                                                                       points.y_coordinates[point], clusters);
+                upper_bounds[point] = sqrt(nearest_clusters.squared_distance);
+                lower_bounds[point] = sqrt(nearest_clusters.second_squared_distance);
+                if (nearest_clusters.cluster_id != cluster_id) {
+                    point_clusters[point] = nearest_clusters.cluster_id;
+                    change_counts[chunk]++;
+                }
+            }
+        });
+        report.iteration_count++;
+        if (std::accumulate(change_counts.begin(), change_counts.end(), size_t(0)) == 0) {
+            report.converged = true;
+            break;
+        }
+        SumCentroids(points, point_clusters, clusters.size(), thread_count, centroids);
+    }
+    if (!report.converged) {
+        // Moved exactly as RunLloydKMeans does, so both still agree when the iteration cap stops the run
+        MoveClustersToCentroids(centroids, clusters);
+    }
+
+    // Volatility points skipped by their bounds have no exact distance yet
+    ComputeAssignedDistances(points, clusters, point_clusters, thread_count, minimum_distances);
+    report.inertia = ComputeInertia(points, minimum_distances);
+    return report;
+}
+
+bool ProjectOntoLine(const VolatilityPointArrays& points, vector<double>& line_coordinates) {
+    line_coordinates.assign(points.point_count, 0);
+    if (points.point_count == 0) {
+        return true;
+    }
+    // The volatility point farthest from the first one sets the direction of the line
+    double x_origin = points.x_coordinates[0];
+    double y_origin = points.y_coordinates[0];
+    double x_direction = 0;
+    double y_direction = 0;
+    double squared_length = 0;
+    for (size_t point = 1; point < points.point_count; point++) {
+        double x_difference = points.x_coordinates[point] - x_origin;
+        double y_difference = points.y_coordinates[point] - y_origin;
+        if (x_difference * x_difference + y_difference * y_difference > squared_length) {
+            x_direction = x_difference;
+            y_direction = y_difference;
+            squared_length = x_difference * x_difference + y_difference * y_difference;
+        }
+    }
+    // Every volatility point is the same
+    if (squared_length == 0) {
+        return true;
+    }
+
+    for (size_t point = 0; point < points.point_count; point++) {
+        double x_difference = points.x_coordinates[point] - x_origin;
+        double y_difference = points.y_coordinates[point] - y_origin;
+        // Cross product is the distance from the line times the length of the direction
+        if (std::abs(x_difference * y_direction - y_difference * x_direction) >
+            kCollinearityTolerance * squared_length) {
+            return false;
+        }
+        line_coordinates[point] = (x_difference * x_direction + y_difference * y_direction) / squared_length;
+    }
+    return true;
+}
+
+ClusteringReport RunOptimalOneDimensionalKMeans(const VolatilityPointArrays& points,
+                                                const vector<double>& line_coordinates, size_t cluster_count,
+                                                size_t thread_count, vector<VolatilityPoint>& clusters,
+                                                vector<Centroid>& centroids, vector<size_t>& point_clusters,
+                                                vector<double>& minimum_distances) {
+    ClusteringReport report = {0, 0, true};
+    clusters.clear();
+    point_clusters.assign(points.point_count, 0);
+    if (points.point_count == 0 || cluster_count == 0) {
+        centroids.clear();
+        minimum_distances.clear();
+        return report;
+    }
+
+    vector<size_t> sorted_points(points.point_count);
+    std::iota(sorted_points.begin(), sorted_points.end(), 0);
+    std::sort(sorted_points.begin(), sorted_points.end(), [&](size_t first_point, size_t second_point) {
+        return line_coordinates[first_point] < line_coordinates[second_point];
+    });
+    double weight_sum = 0;
+    double position_sum = 0;
+    for (size_t point = 0; point < points.point_count; point++) {
+        weight_sum += static_cast<double>(points.weights[point]);
+        position_sum += static_cast<double>(points.weights[point]) * line_coordinates[point];
+    }
+    double mean_position = position_sum / weight_sum;
+
+    // Volatility points at the same position always share a cluster, so each position forms one group
+    vector<size_t> group_starts;
+    LinePrefixSums prefix_sums = {{0}, {0}, {0}};
+    for (size_t rank = 0; rank < sorted_points.size(); rank++) {
+        size_t point = sorted_points[rank];
+        if (rank == 0 || line_coordinates[point] != line_coordinates[sorted_points[rank - 1]]) {
+            group_starts.push_back(rank);
+            prefix_sums.weights.push_back(prefix_sums.weights.back());
+            prefix_sums.sums.push_back(prefix_sums.sums.back());
+            prefix_sums.squared_sums.push_back(prefix_sums.squared_sums.back());
+        }
+        double weight = static_cast<double>(points.weights[point]);
+        double position = line_coordinates[point] - mean_position;
+        prefix_sums.weights.back() += weight;
+        prefix_sums.sums.back() += weight * position;
+        prefix_sums.squared_sums.back() += weight * position * position;
+    }
+    size_t group_count = group_starts.size();
+    group_starts.push_back(points.point_count);
+    cluster_count = std::min(cluster_count, group_count);
+
+    // Lowest cost of splitting the first groups into one cluster more per layer, and the start of the last cluster
+    vector<size_t> splits(cluster_count * (group_count + 1));
+    vector<double> previous_costs(group_count + 1, DBL_MAX);
+    vector<double> costs(group_count + 1, DBL_MAX);
+    for (size_t end = 1; end <= group_count; end++) {
+        previous_costs[end] = prefix_sums.ComputeCost(0, end);
+    }
+    for (size_t layer = 1; layer < cluster_count; layer++) {
+        // Every earlier cluster holds at least one group, and every later cluster leaves one for itself
+        FillCostLayer(prefix_sums, previous_costs, layer + 1, group_count - (cluster_count - layer - 1), layer,
+                      group_count - 1, costs, splits.data() + layer * (group_count + 1));
+        previous_costs.swap(costs);
+    }
+
+    clusters.assign(cluster_count, VolatilityPoint{kNoLabel_, 0, 0});
+    size_t end = group_count;
+    for (size_t layer = cluster_count; layer-- > 0;) {
+        size_t begin = layer == 0 ? 0 : splits[layer * (group_count + 1) + end];
+        for (size_t rank = group_starts[begin]; rank < group_starts[end]; rank++) {
+            point_clusters[sorted_points[rank]] = layer;
+        }
+        end = begin;
+    }
+    SumCentroids(points, point_clusters, cluster_count, thread_count, centroids);
+    MoveClustersToCentroids(centroids, clusters);
+    ComputeAssignedDistances(points, clusters, point_clusters, thread_count, minimum_distances);
+    report.inertia = ComputeInertia(points, minimum_distances);
+    return report;
+}
+
+void FoldMiniBatch(const VolatilityPointArrays& batch, size_t thread_count, vector<VolatilityPoint>& clusters,
+                   vector<Centroid>& centroids, vector<size_t>& batch_clusters) {
+    vector<double> minimum_distances;
+    AssignNearestClusters(batch, clusters, thread_count, batch_clusters, minimum_distances);
+    for (size_t point = 0; point < batch.point_count; point++) {
+        VolatilityPoint& cluster = clusters[batch_clusters[point]];
+        Centroid& centroid = centroids[batch_clusters[point]];
+        double weight = static_cast<double>(batch.weights[point]);
+        centroid.point_count += batch.weights[point];
+        centroid.x_coordinate_sum += weight * batch.x_coordinates[point];
+        centroid.y_coordinate_sum += weight * batch.y_coordinates[point];
+        // Equal to stepping towards the volatility point by its weight over the updated point count, but also holds
+        // when the cluster did not start at the mean of its centroid
+        cluster.positive_z_score_probability = centroid.x_coordinate_sum / centroid.point_count;
+        cluster.negative_z_score_probability = centroid.y_coordinate_sum / centroid.point_count;
+    }
+}
+
+double ComputeInertia(const VolatilityPointArrays& points, const vector<double>& minimum_distances) {
+    double inertia = 0;
+    for (size_t point = 0; point < points.point_count; point++) {
+        inertia += static_cast<double>(points.weights[point]) * minimum_distances[point];
+    }
+    return inertia;
+}
+
+}
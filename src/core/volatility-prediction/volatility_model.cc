@@ -1,9 +1,12 @@
 #include "core/volatility-prediction/volatility_model.h"
+#include "core/volatility-prediction/volatility_clustering.h"
 #include "core/data_processor.h"
 #include "core/momentum-prediction/momentum_training_data_factory.h"
 #include "core/momentum-prediction/momentum_model.h"
 #include "core/volatility-prediction/volatility_training_data_factory.h"
+#include <algorithm>
 #include <codecvt>
+#include <float.h>
 
 using std::ifstream;
 using std::invalid_argument;
@@ -14,52 +17,104 @@ void VolatilityModel::SetFileLine(const string& file_line) {
     file_line_ = file_line;
 }
 
-string VolatilityModel::GetVolatilityType(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
+void VolatilityModel::GenerateVolatilityPoint() {
+    for (char training_data_character : file_line_) {
+        if (training_data_character == kVolatilityTrainingDataCharacters_[0]) {
+            current_volatility_point_.positive_z_score_probability++;
+        } else {
+            current_volatility_point_.negative_z_score_probability++;
+        }
     }
-    return volatility_points_[vector_index].volatility_type;
-}
+    current_volatility_point_.positive_z_score_probability /= file_line_.length();
+    current_volatility_point_.negative_z_score_probability /= file_line_.length();
 
-double VolatilityModel::GetPositiveZScoreProbability(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
+    // Once trained, an online model folds volatility points into its clusters in batches instead of storing them
+    if (is_trained_ && online_batch_size_ != 0) {
+        pending_volatility_points_.push_back(current_volatility_point_);
+        if (pending_volatility_points_.size() >= online_batch_size_) {
+            FlushVolatilityPoints();
+        }
+        return;
     }
-    return volatility_points_[vector_index].positive_z_score_probability;
-}
 
-double VolatilityModel::GetNegativeZScoreProbability(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
+    // Identical volatility points with the same volatility type are stored once along with their multiplicity
+    VolatilityPointKey key = {{current_volatility_point_.positive_z_score_probability,
+                               current_volatility_point_.negative_z_score_probability},
+                              current_volatility_point_.volatility_type};
+    auto unique_point = unique_point_indices_.emplace(key, volatility_types_.size());
+    if (unique_point.second) {
+        positive_z_score_probabilities_.emplace_back(current_volatility_point_.positive_z_score_probability);
+        negative_z_score_probabilities_.emplace_back(current_volatility_point_.negative_z_score_probability);
+        volatility_types_.emplace_back(current_volatility_point_.volatility_type);
+        point_multiplicities_.emplace_back(1);
+        point_clusters_.emplace_back(0);
+        minimum_distances_.emplace_back(0);
+    } else {
+        point_multiplicities_[unique_point.first->second]++;
     }
-    return volatility_points_[vector_index].negative_z_score_probability;
+    point_unique_indices_.emplace_back(unique_point.first->second);
 }
 
-double VolatilityModel::GetMinimumDistance(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return volatility_points_[vector_index].minimum_distance;
+size_t VolatilityModel::GetVolatilityPointCount() const {
+    return point_unique_indices_.size();
 }
 
-size_t VolatilityModel::GetClusterValue(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return volatility_points_[vector_index].cluster;
+size_t VolatilityModel::GetUniquePointCount() const {
+    return volatility_types_.size();
 }
 
-void VolatilityModel::GenerateVolatilityPoint() {
-    for (char training_data_character : file_line_) {
-        if (training_data_character == kVolatilityTrainingDataCharacters_[0]) {
-            current_volatility_point_.positive_z_score_probability++;
-        } else {
-            current_volatility_point_.negative_z_score_probability++;
-        }
+size_t VolatilityModel::GetClusterCount() const {
+    return clusters_.size();
+}
+
+ArrayView<double> VolatilityModel::GetPositiveZScoreProbabilities() const {
+    return positive_z_score_probabilities_;
+}
+
+ArrayView<double> VolatilityModel::GetNegativeZScoreProbabilities() const {
+    return negative_z_score_probabilities_;
+}
+
+ArrayView<LabelId> VolatilityModel::GetVolatilityTypes() const {
+    return volatility_types_;
+}
+
+ArrayView<size_t> VolatilityModel::GetPointMultiplicities() const {
+    return point_multiplicities_;
+}
+
+ArrayView<size_t> VolatilityModel::GetPointClusters() const {
+    return point_clusters_;
+}
+
+ArrayView<double> VolatilityModel::GetMinimumDistances() const {
+    return minimum_distances_;
+}
+
+ArrayView<size_t> VolatilityModel::GetPointUniqueIndices() const {
+    return point_unique_indices_;
+}
+
+ArrayView<VolatilityPoint> VolatilityModel::GetClusters() const {
+    return clusters_;
+}
+
+ArrayView<Centroid> VolatilityModel::GetCentroids() const {
+    return centroids_;
+}
+
+bool VolatilityModel::VolatilityPointKey::operator==(const VolatilityPointKey& key) const {
+    return coordinates[0] == key.coordinates[0] && coordinates[1] == key.coordinates[1] &&
+           volatility_type == key.volatility_type;
+}
+
+size_t VolatilityModel::VolatilityPointKeyHash::operator()(const VolatilityPointKey& key) const {
+    std::hash<double> hash_coordinate;
+    size_t hash = key.volatility_type;
+    for (double coordinate : key.coordinates) {
+        hash = hash * 31 + hash_coordinate(coordinate);
     }
-    current_volatility_point_.positive_z_score_probability /= file_line_.length();
-    current_volatility_point_.negative_z_score_probability /= file_line_.length();
-    volatility_points_.emplace_back(current_volatility_point_);
+    return hash;
 }
 
 istream &operator>>(istream &input, VolatilityModel& model) {
@@ -88,31 +143,13 @@ istream &operator>>(istream &input, VolatilityModel& model) {
         }
 
         if (!is_training_data_line) {
-            model.current_volatility_point_.volatility_type = model.file_line_;
+            model.current_volatility_point_.volatility_type = ParseVolatilityType(model.file_line_);
         }
         model.GenerateVolatilityPoint();
     }
     return input;
 }
 
-size_t VolatilityModel::GetClusterCount() {
-    return clusters_.size();
-}
-
-VolatilityPoint VolatilityModel::GetCluster(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return clusters_[vector_index];
-}
-
-Centroid VolatilityModel::GetCentroid(size_t vector_index) {
-    if (vector_index >= volatility_points_.size()) {
-        throw invalid_argument("Index out of bounds");
-    }
-    return centroids_[vector_index];
-}
-
 VolatilityModel VolatilityModel::ValidateFile(const string& file_path) {
     ifstream file;
     file.open(file_path);
@@ -128,41 +165,153 @@ VolatilityModel VolatilityModel::ValidateFile(const string& file_path) {
 }
 
 void VolatilityModel::UpdateCentroidData() {
-    centroids_.reserve(volatility_points_.size());
-    centroids_.resize(volatility_points_.size());
-    for (const VolatilityPoint& point : volatility_points_) {
-        size_t cluster_id = point.cluster;
-        centroids_[cluster_id].point_count += 1;
-        centroids_[cluster_id].x_coordinate_sum += point.positive_z_score_probability;
-        centroids_[cluster_id].y_coordinate_sum += point.negative_z_score_probability;
+    SumCentroids(GetPointArrays(), point_clusters_, clusters_.size(), thread_count_, centroids_);
+    MoveClustersToCentroids(centroids_, clusters_);
+}
+
+void VolatilityModel::AssignClusterPoints(size_t cluster_count) {
+    SeedKMeansPlusPlus(GetPointArrays(), cluster_count, generator_, clusters_, minimum_distances_);
+    AssignNearestClusters(GetPointArrays(), clusters_, thread_count_, point_clusters_, minimum_distances_);
+}
+
+void VolatilityModel::Train(size_t cluster_count) {
+    if (cluster_count == 0 || volatility_types_.empty()) {
+        throw invalid_argument("Index out of bounds");
+    }
+    ClusteringReport report;
+    vector<double> line_coordinates;
+    if (clustering_method_ == ClusteringMethod::OneDimensional && ProjectOntoLine(GetPointArrays(), line_coordinates)) {
+        report = RunOptimalOneDimensionalKMeans(GetPointArrays(), line_coordinates, cluster_count, thread_count_,
+                                                clusters_, centroids_, point_clusters_, minimum_distances_);
+    } else {
+        SeedKMeansPlusPlus(GetPointArrays(), cluster_count, generator_, clusters_, minimum_distances_);
+        if (clustering_method_ == ClusteringMethod::Lloyd) {
+            report = RunLloydKMeans(GetPointArrays(), maximum_iteration_count_, thread_count_, clusters_, centroids_,
+                                    point_clusters_, minimum_distances_);
+        } else {
+            report = RunHamerlyKMeans(GetPointArrays(), maximum_iteration_count_, thread_count_, clusters_,
+                                      centroids_, point_clusters_, minimum_distances_);
+        }
     }
+    iteration_count_ = report.iteration_count;
+    inertia_ = report.inertia;
 
+    cluster_type_counts_.assign(clusters_.size() * kVolatilityTypeCount_, 0);
+    for (size_t unique_index = 0; unique_index < volatility_types_.size(); unique_index++) {
+        if (volatility_types_[unique_index] != kNoLabel_) {
+            cluster_type_counts_[point_clusters_[unique_index] * kVolatilityTypeCount_ +
+                                 volatility_types_[unique_index]] += point_multiplicities_[unique_index];
+        }
+    }
     for (size_t cluster_id = 0; cluster_id < clusters_.size(); cluster_id++) {
-        clusters_[cluster_id].volatility_type = volatility_points_[cluster_id].volatility_type;
-        clusters_[cluster_id].positive_z_score_probability = centroids_[cluster_id].x_coordinate_sum /
-                centroids_[cluster_id].point_count;
-        clusters_[cluster_id].negative_z_score_probability = centroids_[cluster_id].y_coordinate_sum /
-                centroids_[cluster_id].point_count;
+        LabelCluster(cluster_id);
     }
+    is_trained_ = true;
 }
 
-void VolatilityModel::AssignClusterPoints(size_t cluster_count) {
-    // Initialize clusters
-    clusters_.reserve(cluster_count);
-    for (size_t i = 0; i < cluster_count; i++) {
-        clusters_.emplace_back(volatility_points_[rand() % volatility_points_.size()]);
+void VolatilityModel::FoldVolatilityPoints(const vector<VolatilityPoint>& volatility_points) {
+    if (!is_trained_) {
+        throw invalid_argument("Model is not trained");
+    }
+    vector<double> x_coordinates;
+    vector<double> y_coordinates;
+    x_coordinates.reserve(volatility_points.size());
+    y_coordinates.reserve(volatility_points.size());
+    for (const VolatilityPoint& point : volatility_points) {
+        x_coordinates.push_back(point.positive_z_score_probability);
+        y_coordinates.push_back(point.negative_z_score_probability);
     }
+    vector<size_t> weights(volatility_points.size(), 1);
+    vector<size_t> batch_clusters;
+    FoldMiniBatch({x_coordinates.data(), y_coordinates.data(), weights.data(), volatility_points.size()},
+                  thread_count_, clusters_, centroids_, batch_clusters);
 
-    // Set ID to index of cluster and minimum distance to closest point
+    for (size_t point = 0; point < volatility_points.size(); point++) {
+        if (volatility_points[point].volatility_type != kNoLabel_) {
+            cluster_type_counts_[batch_clusters[point] * kVolatilityTypeCount_ +
+                                 volatility_points[point].volatility_type]++;
+        }
+    }
     for (size_t cluster_id = 0; cluster_id < clusters_.size(); cluster_id++) {
-        for (VolatilityPoint& point: volatility_points_) {
-            double distance = clusters_[cluster_id].ComputeDistance(point);
-            if (distance < point.minimum_distance) {
-                point.minimum_distance = distance;
-                point.cluster = cluster_id;
-            }
+        LabelCluster(cluster_id);
+    }
+}
+
+void VolatilityModel::SetOnlineBatchSize(size_t online_batch_size) {
+    online_batch_size_ = online_batch_size;
+    pending_volatility_points_.reserve(online_batch_size);
+}
+
+void VolatilityModel::FlushVolatilityPoints() {
+    if (!pending_volatility_points_.empty()) {
+        FoldVolatilityPoints(pending_volatility_points_);
+        pending_volatility_points_.clear();
+    }
+}
+
+size_t VolatilityModel::GetPendingPointCount() const {
+    return pending_volatility_points_.size();
+}
+
+LabelId VolatilityModel::ClassifyVolatilityPoint(double positive_z_score_probability,
+                                                 double negative_z_score_probability) const {
+    if (!is_trained_) {
+        throw invalid_argument("Model is not trained");
+    }
+    VolatilityPoint point = {kNoLabel_, positive_z_score_probability, negative_z_score_probability};
+    double minimum_distance = DBL_MAX;
+    LabelId volatility_type = kNoLabel_;
+    for (size_t cluster_id = 0; cluster_id < clusters_.size(); cluster_id++) {
+        // Clusters left without volatility points have no position
+        if (centroids_[cluster_id].point_count == 0) {
+            continue;
+        }
+        double distance = clusters_[cluster_id].ComputeDistance(point);
+        if (distance < minimum_distance) {
+            minimum_distance = distance;
+            volatility_type = clusters_[cluster_id].volatility_type;
         }
     }
+    return volatility_type;
+}
+
+bool VolatilityModel::IsTrained() const {
+    return is_trained_;
+}
+
+void VolatilityModel::SetMaximumIterationCount(size_t maximum_iteration_count) {
+    maximum_iteration_count_ = maximum_iteration_count;
+}
+
+void VolatilityModel::SetClusteringMethod(ClusteringMethod clustering_method) {
+    clustering_method_ = clustering_method;
+}
+
+void VolatilityModel::SetRandomSeed(uint64_t random_seed) {
+    generator_.seed(random_seed);
+}
+
+void VolatilityModel::SetThreadCount(size_t thread_count) {
+    thread_count_ = thread_count;
+}
+
+size_t VolatilityModel::GetIterationCount() const {
+    return iteration_count_;
+}
+
+double VolatilityModel::GetInertia() const {
+    return inertia_;
+}
+
+VolatilityPointArrays VolatilityModel::GetPointArrays() const {
+    return {positive_z_score_probabilities_.data(), negative_z_score_probabilities_.data(),
+            point_multiplicities_.data(), volatility_types_.size()};
+}
+
+void VolatilityModel::LabelCluster(size_t cluster_id) {
+    const size_t* type_counts = cluster_type_counts_.data() + cluster_id * kVolatilityTypeCount_;
+    size_t type_id = std::max_element(type_counts, type_counts + kVolatilityTypeCount_) - type_counts;
+    clusters_[cluster_id].volatility_type = type_counts[type_id] == 0 ? kNoLabel_ : static_cast<LabelId>(type_id);
 }
 
 }
@@ -1,15 +1,14 @@
 #include "core/volatility-prediction/volatility_training_data_factory.h"
 #include "core/momentum-prediction/momentum_model.h"
 #include "core/volatility-prediction/volatility_calculator.h"
-#include "core/data_processor.h"
 #include "core/date.h"
+#include "core/parallel.h"
+#include "core/price_kernels.h"
 #include <iostream>
 #include <codecvt>
 #include <numeric>
 #include <sstream>
 
-using std::ifstream;
-using std::invalid_argument;
 using std::accumulate;
 using std::inner_product;
 using std::stringstream;
@@ -17,15 +16,18 @@ using std::stringstream;
 namespace finadvisor {
 
 ostream& operator<<(ostream& output, VolatilityTrainingDataFactory& factory) {
-    for (const auto& pair : factory.volatility_by_standardized_quartile_price_) {
-        output << kVolatilityMeasures_[static_cast<int>(pair.second.measure)] << " " <<
-               kVolatilityCategories_[static_cast<int>(pair.second.category)];
+    const MonthTable<Volatility>& table = factory.volatility_by_month_;
+    for (size_t month_index = 0; month_index < table.GetMonthCount(); month_index++) {
+        const Volatility& volatility = table.GetLabel(month_index);
+        output << kVolatilityMeasures_[static_cast<int>(volatility.measure)] << " " <<
+               kVolatilityCategories_[static_cast<int>(volatility.category)];
         output << kNewLineCharacter_;
         std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-        for (double standardized_quartile_price : pair.first) {
+        for (const double* standardized_quartile_price = table.GetValuesBegin(month_index);
+             standardized_quartile_price != table.GetValuesEnd(month_index); standardized_quartile_price++) {
             // Code below derived from:
             // https://stackoverflow.com/questions/18534494/convert-from-utf-8-to-unicode-c
-            if (standardized_quartile_price >= 0) {
+            if (*standardized_quartile_price >= 0) {
                 // For sake of simplicity with the k means clustering algorithm, a Z-score of 0 is considered positive.
                 // Making such a simplification has a negligible effect on accuracy due to shifts in central tendency.
                 output << converter.from_bytes(kVolatilityTrainingDataCharacters_[0]).c_str();
@@ -39,16 +41,16 @@ ostream& operator<<(ostream& output, VolatilityTrainingDataFactory& factory) {
     return output;
 }
 
-Volatility VolatilityTrainingDataFactory::GetVolatility(size_t map_index) {
-    std::pair<const vector<double>, Volatility> &nth_element = *std::next(
-            volatility_by_standardized_quartile_price_.begin(), map_index);
-    return nth_element.second;
+Volatility VolatilityTrainingDataFactory::GetVolatility(size_t month_index) const {
+    return volatility_by_month_.GetLabel(month_index);
 }
 
-std::vector<double> VolatilityTrainingDataFactory::GetStandardizedQuartilePrices(size_t map_index) {
-    std::pair<const vector<double>, Volatility> &nth_element = *std::next(
-            volatility_by_standardized_quartile_price_.begin(), map_index);
-    return nth_element.first;
+std::vector<double> VolatilityTrainingDataFactory::GetStandardizedQuartilePrices(size_t month_index) const {
+    return volatility_by_month_.GetValues(month_index);
+}
+
+size_t VolatilityTrainingDataFactory::FindMonth(size_t series_index, size_t year, size_t month) const {
+    return volatility_by_month_.FindMonth(series_index, year, month);
 }
 
 string VolatilityTrainingDataFactory::WriteToOutputFile(VolatilityTrainingDataFactory& factory) {
@@ -64,53 +66,142 @@ DailyPrice VolatilityTrainingDataFactory::GetDailyPrice(size_t vector_index) {
     return daily_prices_[vector_index];
 }
 
-void VolatilityTrainingDataFactory::UpdateDailyPrices(const string& line) {
-    DailyPrice price;
-    DataProcessor processor;
-    daily_prices_.reserve(daily_prices_.size() + 1);
-    price.opening_price = stod(processor.Split(line, kParseCharacter_)[MomentumTrainingDataFactory::GetOpeningPriceIndex()]);
-    price.closing_price = stod(processor.Split(line, kParseCharacter_)[MomentumTrainingDataFactory::GetClosingPriceIndex()]);
-    price.high_price = stod(processor.Split(line, kParseCharacter_)[VolatilityTrainingDataFactory::kHighPriceIndex_]);
-    price.low_price = stod(processor.Split(line, kParseCharacter_)[VolatilityTrainingDataFactory::kLowPriceIndex_]);
+void VolatilityTrainingDataFactory::InsertCurrentMonth() {
+    VolatilityCalculator calculator;
+    vector<double> standardized_quartile_prices(quartile_prices_.size());
+    VolatilityStatistics statistics = calculator.ComputeVolatilityStatistics(
+            quartile_prices_.data(), quartile_prices_.size(), standardized_quartile_prices.data());
+    volatility_by_month_.Append(series_index_, month_key_, standardized_quartile_prices, statistics.volatility);
+    quartile_prices_.clear();
+}
+
+void VolatilityTrainingDataFactory::UpdateDailyPrices(size_t series_index, const Date& date,
+                                                      const DailyPrice& price, double quartile_price) {
+    VolatilityCalculator calculator;
+    // The first row of a new series always closes out the month left open by the previous series
+    if ((series_index_ != series_index || month_key_ != date.GetMonthKey()) && !quartile_prices_.empty()) {
+        InsertCurrentMonth();
+    }
+    if (rolling_window_length_ > 0) {
+        // Rolling windows never span two series
+        if (series_index_ != series_index) {
+            rolling_window_.Clear();
+        }
+        rolling_window_.Add(quartile_price);
+        if (rolling_window_.IsFull()) {
+            rolling_volatilities_.emplace_back(calculator.IdentifyVolatility(rolling_window_));
+            rolling_window_end_dates_.emplace_back(date);
+        }
+    }
+    series_index_ = series_index;
+    month_key_ = date.GetMonthKey();
     daily_prices_.emplace_back(price);
+    quartile_prices_.emplace_back(quartile_price);
 }
 
 istream& operator>>(istream& input, VolatilityTrainingDataFactory& factory) {
     string line;
-    size_t month = 0;
+    CsvRow row;
     VolatilityCalculator calculator;
-    DataProcessor processor;
+    // Every stream is a new price series
+    size_t series_index = factory.series_count_++;
     while (getline(input, line)) {
-        Date date(processor.Split(line, kParseCharacter_)[0]);
-        if (month != date.GetMonth() && !factory.quartile_prices_.empty()) {
-            factory.volatility_by_standardized_quartile_price_.insert({calculator.StandardizeQuartilePrices(
-                    factory.quartile_prices_), calculator.IdentifyVolatility(factory.quartile_prices_)});
-            factory.quartile_prices_.clear();
+        if (row.Parse(line.data(), line.data() + line.size())) {
+            DailyPrice price;
+            price.opening_price = row.GetDouble(MomentumTrainingDataFactory::GetOpeningPriceIndex());
+            price.closing_price = row.GetDouble(MomentumTrainingDataFactory::GetClosingPriceIndex());
+            price.high_price = row.GetDouble(VolatilityTrainingDataFactory::kHighPriceIndex_);
+            price.low_price = row.GetDouble(VolatilityTrainingDataFactory::kLowPriceIndex_);
+            factory.UpdateDailyPrices(series_index, row.GetDate(0), price, calculator.CalculateQuartilePrice(
+                    price.opening_price, price.closing_price, price.high_price, price.low_price));
         }
-        month = date.GetMonth();
-        factory.quartile_prices_.reserve(factory.quartile_prices_.size() + 1);
-        factory.UpdateDailyPrices(line);
-        DailyPrice price = factory.daily_prices_[factory.daily_prices_.size() - 1];
-        factory.quartile_prices_.emplace_back(calculator.CalculateQuartilePrice(
-                price.opening_price, price.closing_price, price.high_price, price.low_price));
     }
     return input;
 }
 
-VolatilityTrainingDataFactory VolatilityTrainingDataFactory::ValidateFiles(const vector<string>& file_paths) const {
-    VolatilityTrainingDataFactory factory;
-    ifstream file;
-    for (const string& file_path : file_paths) {
-        file.open(file_path);
-        if (file.fail() || file.bad() || file.eof()) {
-            file.close();
-            throw invalid_argument("Cannot open file");
-        } else {
-            file >> factory;
-            file.close();
+void VolatilityTrainingDataFactory::MergeSeries(VolatilityTrainingDataFactory& series_factory) {
+    if (series_factory.daily_prices_.empty()) {
+        return;
+    }
+    // The first row of a new series always closes out the month left open by the previous series
+    if (!quartile_prices_.empty()) {
+        InsertCurrentMonth();
+    }
+    volatility_by_month_.AppendTable(series_factory.volatility_by_month_);
+    rolling_volatilities_.insert(rolling_volatilities_.end(), series_factory.rolling_volatilities_.begin(),
+                                 series_factory.rolling_volatilities_.end());
+    rolling_window_end_dates_.insert(rolling_window_end_dates_.end(), series_factory.rolling_window_end_dates_.begin(),
+                                     series_factory.rolling_window_end_dates_.end());
+    daily_prices_.insert(daily_prices_.end(), series_factory.daily_prices_.begin(), series_factory.daily_prices_.end());
+    quartile_prices_ = std::move(series_factory.quartile_prices_);
+    month_key_ = series_factory.month_key_;
+    series_index_ = series_factory.series_index_;
+}
+
+void VolatilityTrainingDataFactory::SetThreadCount(size_t thread_count) {
+    thread_count_ = thread_count;
+}
+
+void VolatilityTrainingDataFactory::SetRollingWindowLength(size_t window_length) {
+    rolling_window_length_ = window_length;
+    rolling_window_ = window_length > 0 ? RollingWindow(window_length) : RollingWindow();
+}
+
+size_t VolatilityTrainingDataFactory::GetRollingWindowCount() const {
+    return rolling_volatilities_.size();
+}
+
+Volatility VolatilityTrainingDataFactory::GetRollingVolatility(size_t window_index) const {
+    if (window_index >= rolling_volatilities_.size()) {
+        throw std::invalid_argument("Index out of bounds");
+    }
+    return rolling_volatilities_[window_index];
+}
+
+Date VolatilityTrainingDataFactory::GetRollingWindowEndDate(size_t window_index) const {
+    if (window_index >= rolling_window_end_dates_.size()) {
+        throw std::invalid_argument("Index out of bounds");
+    }
+    return rolling_window_end_dates_[window_index];
+}
+
+size_t VolatilityTrainingDataFactory::GetMonthCount() const {
+    return volatility_by_month_.GetMonthCount();
+}
+
+VolatilityTrainingDataFactory VolatilityTrainingDataFactory::LoadPriceStore(const PriceStore& store) const {
+    vector<VolatilityTrainingDataFactory> series_factories(store.GetSeriesCount());
+    ParallelFor(store.GetSeriesCount(), thread_count_, [&](size_t series_index) {
+        const PriceSeries& series = store.GetSeries(series_index);
+        VolatilityTrainingDataFactory& series_factory = series_factories[series_index];
+        series_factory.SetRollingWindowLength(rolling_window_length_);
+        series_factory.daily_prices_.reserve(series.GetDayCount());
+        vector<double> quartile_prices = ComputeQuartilePrices(series);
+        for (size_t day = 0; day < series.GetDayCount(); day++) {
+            DailyPrice price;
+            price.opening_price = series.opening_prices[day];
+            price.closing_price = series.closing_prices[day];
+            price.high_price = series.high_prices[day];
+            price.low_price = series.low_prices[day];
+            series_factory.UpdateDailyPrices(series_index, series.dates[day], price, quartile_prices[day]);
         }
+    });
+
+    VolatilityTrainingDataFactory factory;
+    factory.thread_count_ = thread_count_;
+    factory.series_count_ = store.GetSeriesCount();
+    factory.SetRollingWindowLength(rolling_window_length_);
+    for (VolatilityTrainingDataFactory& series_factory : series_factories) {
+        factory.MergeSeries(series_factory);
     }
     return factory;
 }
 
-}
\ No newline at end of file
+VolatilityTrainingDataFactory VolatilityTrainingDataFactory::ValidateFiles(const vector<string>& file_paths) const {
+    // Throws invalid argument exception if a file cannot be opened
+    PriceStore store;
+    store.SetThreadCount(thread_count_);
+    return LoadPriceStore(store.ValidateFiles(file_paths));
+}
+
+}
@@ -1,15 +1,13 @@
 #include <visualizer/automated_finadvisor_app.h>
 #include "core/momentum-prediction/momentum_training_data_factory.h"
+#include <algorithm>
 #include <float.h>
 #include "cinder/Text.h"
 #include <string>
 #include <sstream>
 #include "core/data_processor.h"
 #include "visualizer/technical_chart_visualizer.h"
-#include "core/momentum-prediction/momentum_classifier.h"
-#include "core/momentum-prediction/momentum_model.h"
-#include "core/volatility-prediction/volatility_model.h"
-#include "core/volatility-prediction/volatility_classifier.h"
+#include "core/label_table.h"
 
 using std::to_string;
 
@@ -31,6 +29,11 @@ double AutomatedFinadvisorApp::GetMargin() {
 
 AutomatedFinadvisorApp::AutomatedFinadvisorApp() {
     ci::app::setWindowSize((int) kWindowSize_, (int) kWindowSize_);
+    // Later launches load the binary cache written next to each csv file instead of parsing it again
+    price_store_.SetUseBinaryCache(true);
+    price_store_ = price_store_.ValidateFiles(file_paths_);
+    momentum_factory_ = momentum_factory_.LoadPriceStore(price_store_);
+    volatility_factory_ = volatility_factory_.LoadPriceStore(price_store_);
 }
 
 void AutomatedFinadvisorApp::DrawNextButton() const {
@@ -110,26 +113,30 @@ void AutomatedFinadvisorApp::draw() {
     ci::gl::clear(background_color);
 
     DrawNextButton();
-    vector<std::string> file_paths = {"abengoa.csv"};
     TechnicalChartVisualizer technical_chart_visualizer;
-    technical_chart_visualizer.DrawTechnicalChart(file_paths, month_index_);
+    technical_chart_visualizer.DrawTechnicalChart(momentum_factory_, month_index_);
 
     SketchAxes();
-    finadvisor::VolatilityTrainingDataFactory volatility_factory;
-    volatility_factory = volatility_factory.ValidateFiles(file_paths);
+    const PriceSeries& series = price_store_.GetSeries(0);
     vector<DailyPrice> daily_prices;
     double max_high_price = DBL_MIN;
     double min_low_price = DBL_MAX;
     daily_prices.reserve(kAverageMonthlyTradingDays_);
-    for (size_t i = kAverageMonthlyTradingDays_ * month_index_; i < kAverageMonthlyTradingDays_ * (month_index_ + 1); i++) {
-        DailyPrice daily_price = volatility_factory.GetDailyPrice(i);
+    // Months past the end of the series draw no candles
+    size_t last_day = std::min(kAverageMonthlyTradingDays_ * (month_index_ + 1), series.GetDayCount());
+    for (size_t i = kAverageMonthlyTradingDays_ * month_index_; i < last_day; i++) {
+        DailyPrice daily_price;
+        daily_price.opening_price = series.opening_prices[i];
+        daily_price.closing_price = series.closing_prices[i];
+        daily_price.high_price = series.high_prices[i];
+        daily_price.low_price = series.low_prices[i];
         if (daily_price.high_price > max_high_price) {
             max_high_price = daily_price.high_price;
         }
         if (daily_price.low_price < min_low_price) {
             min_low_price = daily_price.low_price;
         }
-        daily_prices.emplace_back(volatility_factory.GetDailyPrice(i));
+        daily_prices.emplace_back(daily_price);
     }
     SketchCandleBody(daily_prices, max_high_price, min_low_price);
 
@@ -190,25 +197,14 @@ void AutomatedFinadvisorApp::keyDown(ci::app::KeyEvent event) {
             current_volatility_prediction_ = "";
             break;
         case ci::app::KeyEvent::KEY_RETURN:
-            vector<std::string> file_paths = {"abengoa.csv"};
             try {
-                finadvisor::MomentumTrainingDataFactory momentum_factory;
-                momentum_factory = momentum_factory.ValidateFiles(file_paths);
-                current_momentum_prediction_ = kMomentumCategories_[static_cast<int>(
-                        momentum_factory.GetMomentum(month_index_).category)] + " " + kMomentumDirections_[
-                                static_cast<int>(momentum_factory.GetMomentum(month_index_).direction)];
-                finadvisor::MomentumClassifier momentum_classifier;
-                finadvisor::MomentumModel momentum_model;
-                momentum_classifier.CalculateValidationAccuracy(momentum_model, 0);
-
-                finadvisor::VolatilityTrainingDataFactory volatility_factory;
-                volatility_factory = volatility_factory.ValidateFiles(file_paths);
-                current_volatility_prediction_ = kVolatilityMeasures_[static_cast<int>(
-                        volatility_factory.GetVolatility(month_index_).measure)] + " " + kVolatilityCategories_[
-                                static_cast<int>(volatility_factory.GetVolatility(month_index_).category)];
-                finadvisor::VolatilityClassifier volatility_classifier;
-                finadvisor::VolatilityModel volatility_model;
-                volatility_classifier.CalculateValidationAccuracy(volatility_model, 0);
+                finadvisor::Momentum momentum = momentum_factory_.GetMomentum(month_index_);
+                current_momentum_prediction_ = finadvisor::FormatMomentumTrend(
+                        finadvisor::GetMomentumTrendId(momentum));
+
+                finadvisor::Volatility volatility = volatility_factory_.GetVolatility(month_index_);
+                current_volatility_prediction_ = finadvisor::FormatVolatilityType(
+                        finadvisor::GetVolatilityTypeId(volatility));
             } catch (const std::exception& exception) {
                 month_index_--;
             }
@@ -21,7 +21,7 @@ void CandlestickChartVisualizer::SketchCandleWicks(float horizontal_position, fl
                                                    float scaled_low_price) const {
 }
 
-void CandlestickChartVisualizer::DrawCandlestickChart(const vector<string> file_paths, size_t month_index) const {
+void CandlestickChartVisualizer::DrawCandlestickChart(const PriceSeries& series, size_t month_index) const {
 }
 
 }
@@ -41,9 +41,8 @@ void TechnicalChartVisualizer::SketchTrendLines(const vector<double> &price_diff
     }
 }
 
-void TechnicalChartVisualizer::DrawTechnicalChart(const vector<string>& file_paths, size_t month_index) const {
-    finadvisor::MomentumTrainingDataFactory momentum_factory;
-    momentum_factory = momentum_factory.ValidateFiles(file_paths);
+void TechnicalChartVisualizer::DrawTechnicalChart(const MomentumTrainingDataFactory& momentum_factory,
+                                                  size_t month_index) const {
     vector<double> price_differences = momentum_factory.GetPriceDifferences(month_index);
     SketchAxes();
     SketchTrendLines(price_differences, static_cast<float>(AutomatedFinadvisorApp::GetWindowSize()) / 20,
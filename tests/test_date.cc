@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+#include "core/date.h"
+
+TEST_CASE("Parsing of date") {
+    SECTION("Fixed width date") {
+        Date date("2009-04-01");
+        REQUIRE(date.GetYear() == 2009);
+        REQUIRE(date.GetMonth() == 4);
+        REQUIRE(date.GetDay() == 1);
+    }
+
+    SECTION("Date without leading zeros") {
+        Date date("2009-4-1");
+        REQUIRE(date == Date(2009, 4, 1));
+    }
+
+    SECTION("Date with invalid characters") {
+        REQUIRE_THROWS_AS(Date("2009/04/01"), std::invalid_argument);
+    }
+
+    SECTION("Date with missing component") {
+        REQUIRE_THROWS_AS(Date("2009-04"), std::invalid_argument);
+    }
+
+    SECTION("Month out of range") {
+        REQUIRE_THROWS_AS(Date("2009-13-01"), std::invalid_argument);
+    }
+
+    SECTION("Packed value round trip") {
+        Date date(1994, 11, 17);
+        REQUIRE(Date::FromPackedValue(date.GetPackedValue()) == date);
+    }
+}
+
+TEST_CASE("Ordering of dates") {
+    SECTION("Earlier day") {
+        REQUIRE(Date(2009, 4, 1) < Date(2009, 4, 2));
+    }
+
+    SECTION("Earlier month") {
+        REQUIRE(Date(2009, 3, 31) < Date(2009, 4, 1));
+    }
+
+    SECTION("Earlier year") {
+        REQUIRE(Date(2008, 12, 31) < Date(2009, 1, 1));
+    }
+}
+
+TEST_CASE("Calendar keys of date") {
+    SECTION("Month key is shared within month") {
+        REQUIRE(Date(2009, 4, 1).GetMonthKey() == Date(2009, 4, 30).GetMonthKey());
+    }
+
+    SECTION("Month key increases by one across year boundary") {
+        REQUIRE(Date(2009, 1, 2).GetMonthKey() == Date(2008, 12, 31).GetMonthKey() + 1);
+    }
+
+    SECTION("Same month of different years") {
+        REQUIRE(Date(2009, 4, 1).GetMonthKey() != Date(2010, 4, 1).GetMonthKey());
+    }
+
+    SECTION("Quarter key") {
+        REQUIRE(Date(2009, 1, 1).GetQuarterKey() == Date(2009, 3, 31).GetQuarterKey());
+        REQUIRE(Date(2009, 4, 1).GetQuarterKey() == Date(2009, 3, 31).GetQuarterKey() + 1);
+        REQUIRE(Date(2010, 1, 1).GetQuarterKey() == Date(2009, 12, 31).GetQuarterKey() + 1);
+    }
+
+    SECTION("Week key changes on Monday") {
+        // 2021-05-03 was a Monday
+        REQUIRE(Date(2021, 5, 3).GetWeekKey() == Date(2021, 5, 9).GetWeekKey());
+        REQUIRE(Date(2021, 5, 3).GetWeekKey() == Date(2021, 5, 2).GetWeekKey() + 1);
+    }
+
+    SECTION("Week key across leap day and year boundary") {
+        // 2020-02-24 and 2020-03-02 were Mondays
+        REQUIRE(Date(2020, 3, 2).GetWeekKey() == Date(2020, 2, 24).GetWeekKey() + 1);
+        REQUIRE(Date(2020, 2, 29).GetWeekKey() == Date(2020, 2, 24).GetWeekKey());
+        // 2019-12-30 was a Monday
+        REQUIRE(Date(2020, 1, 5).GetWeekKey() == Date(2019, 12, 30).GetWeekKey());
+    }
+}
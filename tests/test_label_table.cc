@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+#include "core/label_table.h"
+#include "core/momentum-prediction/momentum_model.h"
+#include "core/volatility-prediction/volatility_model.h"
+#include <sstream>
+
+TEST_CASE("Label table") {
+    SECTION("Momentum trends round trip") {
+        for (finadvisor::LabelId trend_id = 0; trend_id < finadvisor::kMomentumTrendCount_; trend_id++) {
+            REQUIRE(finadvisor::ParseMomentumTrend(finadvisor::FormatMomentumTrend(trend_id)) == trend_id);
+        }
+        finadvisor::Momentum momentum = {finadvisor::MomentumCategory::Bearish,
+                                         finadvisor::MomentumDirection::Continuation};
+        REQUIRE(finadvisor::FormatMomentumTrend(finadvisor::GetMomentumTrendId(momentum)) == "Bearish Continuation");
+        REQUIRE(finadvisor::FormatMomentumTrend(finadvisor::kNoLabel_).empty());
+    }
+
+    SECTION("Volatility types round trip") {
+        for (finadvisor::LabelId type_id = 0; type_id < finadvisor::kVolatilityTypeCount_; type_id++) {
+            REQUIRE(finadvisor::ParseVolatilityType(finadvisor::FormatVolatilityType(type_id)) == type_id);
+        }
+        finadvisor::Volatility volatility = {finadvisor::VolatilityMeasure::Low,
+                                             finadvisor::VolatilityCategory::Implied};
+        REQUIRE(finadvisor::FormatVolatilityType(finadvisor::GetVolatilityTypeId(volatility)) == "Low Implied");
+    }
+
+    SECTION("Unknown labels") {
+        REQUIRE_THROWS_AS(finadvisor::ParseMomentumTrend("Bullish"), std::invalid_argument);
+        REQUIRE_THROWS_AS(finadvisor::ParseMomentumTrend("Bullish Reversal "), std::invalid_argument);
+        REQUIRE_THROWS_AS(finadvisor::ParseVolatilityType("High Reversal"), std::invalid_argument);
+        REQUIRE_THROWS_AS(finadvisor::FormatMomentumTrend(finadvisor::kMomentumTrendCount_), std::invalid_argument);
+    }
+
+    SECTION("Models store labels as identifiers") {
+        finadvisor::MomentumModel momentum_model{};
+        std::stringstream momentum_file("Bearish Reversal\n0x7ff84393afe0,0x7ffee0aaaffc,\n");
+        momentum_file >> momentum_model;
+        REQUIRE(momentum_model.GetMomentumTrends()[0] == finadvisor::ParseMomentumTrend("Bearish Reversal"));
+
+        finadvisor::VolatilityModel volatility_model{};
+        std::stringstream volatility_file("Medium Historical\n0x0000002B,0x0000002D,\n");
+        volatility_file >> volatility_model;
+        REQUIRE(finadvisor::FormatVolatilityType(volatility_model.GetVolatilityTypes()[0]) == "Medium Historical");
+    }
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+#include "core/mapped_csv_file.h"
+#include <string>
+
+TEST_CASE("Memory mapped csv file") {
+    SECTION("Non-existent file") {
+        REQUIRE_THROWS_AS(finadvisor::MappedCsvFile("fakefile.csv"), std::invalid_argument);
+    }
+
+    SECTION("First row of valid file") {
+        finadvisor::MappedCsvFile file("stock_data.csv");
+        finadvisor::CsvRow row;
+        REQUIRE(file.NextRow(row));
+        REQUIRE(row.GetColumnCount() == 6);
+        REQUIRE(row.GetDate(0).GetYear() == 2009);
+        REQUIRE(row.GetDate(0).GetMonth() == 4);
+        REQUIRE(row.GetDate(0).GetDay() == 1);
+        REQUIRE(row.GetDouble(1) == 3.08);
+        REQUIRE(row.GetDouble(3) == 2.99);
+    }
+
+    SECTION("Every row is read") {
+        finadvisor::MappedCsvFile file("stock_data.csv");
+        finadvisor::CsvRow row;
+        size_t row_count = 0;
+        while (file.NextRow(row)) {
+            row_count++;
+        }
+        REQUIRE(row_count > 0);
+        REQUIRE_FALSE(file.NextRow(row));
+    }
+}
+
+TEST_CASE("Parsing of csv row") {
+    finadvisor::CsvRow row;
+    std::string line;
+
+    SECTION("Empty line") {
+        REQUIRE_FALSE(row.Parse(line.data(), line.data() + line.size()));
+    }
+
+    SECTION("Carriage return is stripped from last field") {
+        line = "2010-12-31,1.5,2.25\r";
+        REQUIRE(row.Parse(line.data(), line.data() + line.size()));
+        REQUIRE(row.GetColumnCount() == 3);
+        REQUIRE(row.GetDouble(2) == 2.25);
+    }
+
+    SECTION("Column index out of bounds") {
+        line = "2010-12-31,1.5";
+        row.Parse(line.data(), line.data() + line.size());
+        REQUIRE_THROWS_AS(row.GetDouble(2), std::invalid_argument);
+    }
+
+    SECTION("Non-numeric field") {
+        line = "2010-12-31,null";
+        row.Parse(line.data(), line.data() + line.size());
+        REQUIRE_THROWS_AS(row.GetDouble(1), std::invalid_argument);
+    }
+
+    SECTION("Malformed date") {
+        line = "2010/12/31,1.5";
+        row.Parse(line.data(), line.data() + line.size());
+        REQUIRE_THROWS_AS(row.GetDate(0), std::invalid_argument);
+    }
+}
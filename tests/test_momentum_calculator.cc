@@ -84,3 +84,65 @@ TEST_CASE("Momentum Categorization") {
         REQUIRE(static_cast<int>(calculator.IdentifyMomentum(price_differences).category) == 1);
     }
 }
+
+TEST_CASE("Fused momentum statistics") {
+    finadvisor::MomentumCalculator calculator;
+    std::vector<double> price_differences;
+
+    SECTION("Empty window") {
+        REQUIRE_THROWS_AS(calculator.ComputeMomentumStatistics(price_differences.data(), 0), std::invalid_argument);
+    }
+
+    SECTION("Matches separate slope and relative strength index") {
+        price_differences = {10, 15, 16, 17, 9, -4, -2};
+        finadvisor::MomentumStatistics statistics = calculator.ComputeMomentumStatistics(price_differences.data(),
+                                                                                          price_differences.size());
+        REQUIRE(Approx(statistics.linear_regression_slope) ==
+                calculator.ComputeLinearRegressionSlope(price_differences));
+        REQUIRE(Approx(statistics.relative_strength_index) == 128.8461538462);
+    }
+
+    SECTION("Middle day of odd window adds its squared day count to the denominator") {
+        price_differences = {1, 2, 3};
+        // Numerator 2, denominator 2 + 2^2
+        REQUIRE(Approx(calculator.ComputeMomentumStatistics(price_differences.data(), 3).linear_regression_slope) ==
+                2.0 / 6.0);
+    }
+
+    SECTION("Single day window") {
+        price_differences = {5};
+        REQUIRE(calculator.IdentifyMomentum(price_differences).category == finadvisor::MomentumCategory::Indecision);
+    }
+
+    SECTION("Equal price differences have no slope") {
+        for (double price_difference : {0.1, -0.37, 0.03, 1.7, -2.9, 123.456}) {
+            for (size_t day_count = 2; day_count <= 41; day_count++) {
+                price_differences.assign(day_count, price_difference);
+                REQUIRE(calculator.ComputeMomentumStatistics(price_differences.data(),
+                                                             day_count).linear_regression_slope == 0);
+                REQUIRE(calculator.IdentifyMomentum(price_differences).category ==
+                        finadvisor::MomentumCategory::Indecision);
+            }
+        }
+    }
+}
+
+TEST_CASE("Batch momentum categorization") {
+    finadvisor::MomentumCalculator calculator;
+    std::vector<double> price_differences = {6, 3, 2, 1, 5, 7, 20, 15, 10, 5};
+    std::vector<size_t> window_bounds = {0, 6, 10};
+
+    SECTION("Every window matches single window categorization") {
+        std::vector<finadvisor::Momentum> momentums = calculator.IdentifyMomentums(price_differences, window_bounds);
+        REQUIRE(momentums.size() == 2);
+        REQUIRE(momentums[0].category == finadvisor::MomentumCategory::Bullish);
+        REQUIRE(momentums[0].direction == finadvisor::MomentumDirection::Reversal);
+        REQUIRE(momentums[1].category == finadvisor::MomentumCategory::Bearish);
+        REQUIRE(momentums[1].direction == finadvisor::MomentumDirection::Reversal);
+    }
+
+    SECTION("Window past end of price differences") {
+        window_bounds = {0, 11};
+        REQUIRE_THROWS_AS(calculator.IdentifyMomentums(price_differences, window_bounds), std::invalid_argument);
+    }
+}
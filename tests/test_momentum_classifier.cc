@@ -33,7 +33,8 @@ TEST_CASE("Overload of momentum classifier extraction operator") {
     }
 
     SECTION("Momentum trend of first momentum testing point") {
-        REQUIRE(classifier.GetMomentumTestingPoint(0).momentum_trend == "Bearish Reversal");
+        REQUIRE(classifier.GetMomentumTestingPoint(0).momentum_trend ==
+                finadvisor::ParseMomentumTrend("Bearish Reversal"));
     }
 
     SECTION("Price increase probability of last momentum testing point") {
@@ -49,7 +50,8 @@ TEST_CASE("Overload of momentum classifier extraction operator") {
     }
 
     SECTION("Momentum trend of last momentum testing point") {
-        REQUIRE(classifier.GetMomentumTestingPoint(682).momentum_trend == "Bullish Continuation");
+        REQUIRE(classifier.GetMomentumTestingPoint(682).momentum_trend ==
+                finadvisor::ParseMomentumTrend("Bullish Continuation"));
     }
 
 }
\ No newline at end of file
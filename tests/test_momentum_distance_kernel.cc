@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+#include "core/momentum-prediction/momentum_distance_kernel.h"
+#include "core/momentum-prediction/momentum_model.h"
+#include <random>
+#include <sstream>
+
+namespace {
+
+/**
+ * Generates points on a coarse lattice, with repeated points given weights above 1, so distances tie often.
+ */
+void GenerateWeightedPoints(size_t point_count, std::vector<double>& x_coordinates,
+                            std::vector<double>& y_coordinates, std::vector<double>& z_coordinates,
+                            std::vector<size_t>& weights) {
+    std::mt19937 generator(17);
+    for (size_t point = 0; point < point_count; point++) {
+        int increase_days = generator() % 21;
+        int decrease_days = generator() % (21 - increase_days);
+        x_coordinates.emplace_back(increase_days / 20.0);
+        y_coordinates.emplace_back(decrease_days / 20.0);
+        z_coordinates.emplace_back((20 - increase_days - decrease_days) / 20.0);
+        weights.emplace_back(1 + generator() % 3);
+    }
+}
+
+}
+
+TEST_CASE("Brute force momentum distance kernels") {
+    std::vector<double> x_coordinates;
+    std::vector<double> y_coordinates;
+    std::vector<double> z_coordinates;
+    std::vector<size_t> weights;
+    // Not a multiple of any block or vector width, so every remainder loop runs
+    GenerateWeightedPoints(1237, x_coordinates, y_coordinates, z_coordinates, weights);
+    finadvisor::MomentumPointArrays points = {x_coordinates.data(), y_coordinates.data(), z_coordinates.data(),
+                                              weights.data(), x_coordinates.size()};
+    finadvisor::MomentumPointIndex index(x_coordinates, y_coordinates, z_coordinates, weights);
+    std::vector<double> x_queries = {0.3, 0, 0.65, 1.2, 0.05, 0.5, 0.25, 0.9, 0.1, 0.33, 0.7};
+    std::vector<double> y_queries = {0.2, 0, 0.35, -0.1, 0.9, 0.5, 0.25, 0.05, 0.15, 0.33, 0.1};
+    std::vector<double> z_queries = {0.5, 0, 0, 0.4, 0.05, 0, 0.5, 0.05, 0.75, 0.34, 0.2};
+
+    SECTION("Squared distances") {
+        std::vector<double> squared_distances(points.point_count);
+        finadvisor::ComputeSquaredMomentumDistances(points, 0.3, 0.2, 0.5, squared_distances.data());
+        for (size_t point = 0; point < points.point_count; point++) {
+            double distance = finadvisor::ComputeMomentumDistance(0.3 - x_coordinates[point],
+                                                                  0.2 - y_coordinates[point],
+                                                                  0.5 - z_coordinates[point]);
+            REQUIRE(squared_distances[point] == Approx(distance * distance));
+        }
+    }
+
+    SECTION("Batch nearest neighbors match point index") {
+        std::vector<finadvisor::MomentumNeighbor> expected_neighbors;
+        for (size_t k : {1, 7, 40, 600}) {
+            std::vector<std::vector<finadvisor::MomentumNeighbor>> neighbors;
+            finadvisor::FindNearestNeighborsBatch(points, x_queries.data(), y_queries.data(), z_queries.data(),
+                                                  x_queries.size(), k, neighbors);
+            REQUIRE(neighbors.size() == x_queries.size());
+            for (size_t query = 0; query < x_queries.size(); query++) {
+                index.FindNearestNeighbors(k, x_queries[query], y_queries[query], z_queries[query],
+                                           expected_neighbors);
+                REQUIRE(neighbors[query].size() == expected_neighbors.size());
+                for (size_t i = 0; i < expected_neighbors.size(); i++) {
+                    REQUIRE(neighbors[query][i].point_index == expected_neighbors[i].point_index);
+                    REQUIRE(neighbors[query][i].distance == expected_neighbors[i].distance);
+                    REQUIRE(neighbors[query][i].weight == expected_neighbors[i].weight);
+                }
+            }
+        }
+    }
+
+    SECTION("K exceeds total weight") {
+        std::vector<std::vector<finadvisor::MomentumNeighbor>> neighbors;
+        REQUIRE_THROWS_AS(finadvisor::FindNearestNeighborsBatch(points, x_queries.data(), y_queries.data(),
+                                                                z_queries.data(), x_queries.size(),
+                                                                index.GetTotalWeight() + 1, neighbors),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("Batch k nearest labels averages") {
+    finadvisor::MomentumModel model{};
+    std::vector<string> unicode_characters = {"0x7ff84393afe0", "0x7faad7c3e4d0", "0x7ffee0aaaffc"};
+    std::mt19937 generator(19);
+    std::stringstream model_file;
+    for (size_t month = 0; month < 300; month++) {
+        model_file << (generator() % 2 == 0 ? "Bullish Reversal" : "Bearish Continuation") << "\n";
+        for (size_t day = 0; day < 15 + generator() % 9; day++) {
+            model_file << unicode_characters[generator() % 3] << ",";
+        }
+        model_file << "\n";
+    }
+    model_file >> model;
+    std::vector<double> x_queries = {0.3, 0.5, 0.25, 0.9, 1.0 / 3};
+    std::vector<double> y_queries = {0.2, 0.5, 0.25, 0.05, 1.0 / 3};
+    std::vector<double> z_queries = {0.5, 0, 0.5, 0.05, 1.0 / 3};
+    finadvisor::MomentumQueryScratch scratch;
+
+    SECTION("Match single query averages") {
+        for (size_t k : {1, 5, 50}) {
+            std::vector<double> averages;
+            model.ComputeKNearestLabelsAverages(k, x_queries, y_queries, z_queries, averages);
+            REQUIRE(averages.size() == x_queries.size());
+            for (size_t query = 0; query < x_queries.size(); query++) {
+                REQUIRE(averages[query] == model.ComputeKNearestLabelsAverage(k, x_queries[query], y_queries[query],
+                                                                              z_queries[query], scratch));
+            }
+        }
+    }
+
+    SECTION("Coordinate counts differ") {
+        std::vector<double> averages;
+        z_queries.pop_back();
+        REQUIRE_THROWS_AS(model.ComputeKNearestLabelsAverages(5, x_queries, y_queries, z_queries, averages),
+                          std::invalid_argument);
+    }
+}
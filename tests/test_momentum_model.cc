@@ -27,17 +27,18 @@ TEST_CASE("Generation of Momentum Point") {
     finadvisor::MomentumModel model;
     model.SetFileLine("↗↘---↘↘↗↘↘↘↗↘↘-");
     model.GenerateMomentumPoint();
+    finadvisor::ArrayView<size_t> unique_indices = model.GetPointUniqueIndices();
 
     SECTION("Price increase value following function call") {
-        REQUIRE(model.GetPriceIncreaseProbability(0) == 0.2);
+        REQUIRE(model.GetPriceIncreaseProbabilities()[unique_indices[0]] == 0.2);
     }
 
     SECTION("Price decrease value following function call") {
-        REQUIRE(model.GetPriceDecreaseProbability(0) == 0.53333333333);
+        REQUIRE(model.GetPriceDecreaseProbabilities()[unique_indices[0]] == 0.53333333333);
     }
 
     SECTION("Static price value following function call") {
-        REQUIRE(model.GetStaticPriceProbability(0) == 0.26666666666);
+        REQUIRE(model.GetStaticPriceProbabilities()[unique_indices[0]] == 0.26666666666);
     }
 }
 
@@ -45,83 +46,77 @@ TEST_CASE("Overload of extraction operator for Momentum Model") {
     finadvisor::MomentumModel model;
     // Call to ValidateFile invokes extraction operator
     model = model.ValidateFile("training_model_data.csv");
+    finadvisor::ArrayView<size_t> unique_indices = model.GetPointUniqueIndices();
 
     // Tests elements of the momentum points vector
     SECTION("Price Increase Probability of first vector element") {
-        REQUIRE(Approx(model.GetPriceIncreaseProbability(0)) == 0.4334322);
+        REQUIRE(Approx(model.GetPriceIncreaseProbabilities()[unique_indices[0]]) == 0.4334322);
     }
 
     SECTION("Price Decrease Probability of first vector element") {
-        REQUIRE(Approx(model.GetPriceDecreaseProbability(0)) == 0.122334);
+        REQUIRE(Approx(model.GetPriceDecreaseProbabilities()[unique_indices[0]]) == 0.122334);
     }
 
     SECTION("Static Price Probability of first vector element") {
-        REQUIRE(Approx(model.GetStaticPriceProbability(0)) == 0.4442338);
+        REQUIRE(Approx(model.GetStaticPriceProbabilities()[unique_indices[0]]) == 0.4442338);
     }
 
     SECTION("Momentum Trend of first vector element") {
-        REQUIRE(model.GetMomentumTrend(0) == "Bearish Reversal");
+        REQUIRE(finadvisor::FormatMomentumTrend(model.GetMomentumTrends()[unique_indices[0]]) == "Bearish Reversal");
     }
 
     SECTION("Vector element probabilities sum to 1") {
-        REQUIRE(model.GetPriceIncreaseProbability(3) + model.GetPriceDecreaseProbability(3) +
-                model.GetStaticPriceProbability(3) == 1);
+        REQUIRE(model.GetPriceIncreaseProbabilities()[unique_indices[3]] +
+                model.GetPriceDecreaseProbabilities()[unique_indices[3]] +
+                model.GetStaticPriceProbabilities()[unique_indices[3]] == 1);
     }
 
     SECTION("Price Increase Probability of middle vector element") {
-        REQUIRE(Approx(model.GetPriceIncreaseProbability(646)) == 0.4397832);
+        REQUIRE(Approx(model.GetPriceIncreaseProbabilities()[unique_indices[646]]) == 0.4397832);
     }
 
     SECTION("Price Decrease Probability of middle vector element") {
-        REQUIRE(Approx(model.GetPriceDecreaseProbability(646)) == 0.312679);
+        REQUIRE(Approx(model.GetPriceDecreaseProbabilities()[unique_indices[646]]) == 0.312679);
     }
 
     SECTION("Static Price Probability of middle vector element") {
-        REQUIRE(Approx(model.GetStaticPriceProbability(646)) == 0.2475378);
+        REQUIRE(Approx(model.GetStaticPriceProbabilities()[unique_indices[646]]) == 0.2475378);
     }
 
     SECTION("Momentum Trend of middle vector element") {
-        REQUIRE(model.GetMomentumTrend(646) == "Indecision None");
+        REQUIRE(finadvisor::FormatMomentumTrend(model.GetMomentumTrends()[unique_indices[646]]) == "Indecision None");
     }
 
     SECTION("Price Increase Probability of last vector element") {
-        REQUIRE(Approx(model.GetPriceIncreaseProbability(1292)) == 0.324976);
+        REQUIRE(Approx(model.GetPriceIncreaseProbabilities()[unique_indices[1292]]) == 0.324976);
     }
 
     SECTION("Price Decrease Probability of last vector element") {
-        REQUIRE(Approx(model.GetPriceDecreaseProbability(1292)) == 0.1234334);
+        REQUIRE(Approx(model.GetPriceDecreaseProbabilities()[unique_indices[1292]]) == 0.1234334);
     }
 
     SECTION("Static Price Probability of last vector element") {
-        REQUIRE(Approx(model.GetStaticPriceProbability(1292)) == 0.5515906);
+        REQUIRE(Approx(model.GetStaticPriceProbabilities()[unique_indices[1292]]) == 0.5515906);
     }
 
     SECTION("Momentum Trend of last vector element") {
-        REQUIRE(model.GetMomentumTrend(1292) == "Bearish Continuation");
+        REQUIRE(finadvisor::FormatMomentumTrend(model.GetMomentumTrends()[unique_indices[1292]]) ==
+                "Bearish Continuation");
     }
 }
 
-TEST_CASE("Invalid vector indices for Momentum model getter methods") {
+TEST_CASE("Empty Momentum model") {
     finadvisor::MomentumModel model;
 
-    SECTION("Price increase probability") {
-        REQUIRE_THROWS_AS(model.GetPriceIncreaseProbability(78903), std::invalid_argument);
+    SECTION("Views of empty model are empty") {
+        REQUIRE(model.GetPriceIncreaseProbabilities().empty());
+        REQUIRE(model.GetPriceDecreaseProbabilities().empty());
+        REQUIRE(model.GetStaticPriceProbabilities().empty());
+        REQUIRE(model.GetMomentumTrends().empty());
     }
 
-    SECTION("Price decrease probability") {
-        REQUIRE_THROWS_AS(model.GetPriceDecreaseProbability(34097), std::invalid_argument);
-    }
-
-    SECTION("Static price probability") {
-        REQUIRE_THROWS_AS(model.GetStaticPriceProbability(59843454), std::invalid_argument);
-    }
-
-    SECTION("Momentum Trend") {
-        REQUIRE_THROWS_AS(model.GetMomentumTrend(435950545), std::invalid_argument);
-    }
-
-    SECTION("Distance") {
-        REQUIRE_THROWS_AS(model.GetDistance(64453546), std::invalid_argument);
+    SECTION("Trend at distance of empty model") {
+        REQUIRE_THROWS_AS(model.FindTrendIdAtDistance(0.5, 0.2, 0.3, 0.5), std::invalid_argument);
     }
 
 }
@@ -0,0 +1,278 @@
+#include <catch2/catch.hpp>
+#include "core/momentum-prediction/momentum_point_index.h"
+#include "core/momentum-prediction/momentum_model.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+
+/**
+ * Generates points on a coarse lattice, as probabilities over a month of trading days are, so distances tie often.
+ */
+void GeneratePoints(size_t point_count, std::vector<double>& x_coordinates, std::vector<double>& y_coordinates,
+                    std::vector<double>& z_coordinates) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> day_distribution(0, 20);
+    for (size_t point = 0; point < point_count; point++) {
+        int increase_days = day_distribution(generator);
+        int decrease_days = std::uniform_int_distribution<int>(0, 20 - increase_days)(generator);
+        x_coordinates.emplace_back(increase_days / 20.0);
+        y_coordinates.emplace_back(decrease_days / 20.0);
+        z_coordinates.emplace_back((20 - increase_days - decrease_days) / 20.0);
+    }
+}
+
+std::vector<double> ComputeSortedDistances(const std::vector<double>& x_coordinates,
+                                           const std::vector<double>& y_coordinates,
+                                           const std::vector<double>& z_coordinates, double x, double y, double z) {
+    std::vector<double> distances;
+    for (size_t point = 0; point < x_coordinates.size(); point++) {
+        distances.emplace_back(finadvisor::ComputeMomentumDistance(x - x_coordinates[point], y - y_coordinates[point],
+                                                                   z - z_coordinates[point]));
+    }
+    std::sort(distances.begin(), distances.end());
+    return distances;
+}
+
+}
+
+TEST_CASE("Momentum point index matches brute force") {
+    std::vector<double> x_coordinates;
+    std::vector<double> y_coordinates;
+    std::vector<double> z_coordinates;
+    GeneratePoints(1000, x_coordinates, y_coordinates, z_coordinates);
+    finadvisor::MomentumPointIndex index(x_coordinates, y_coordinates, z_coordinates);
+    REQUIRE(index.GetPointCount() == 1000);
+    const double queries[][3] = {{0.3, 0.2, 0.5}, {0, 0, 0}, {0.65, 0.35, 0}, {1.2, -0.1, 0.4}};
+
+    SECTION("K nearest neighbors") {
+        std::vector<finadvisor::MomentumNeighbor> neighbors;
+        for (const auto& query : queries) {
+            std::vector<double> distances = ComputeSortedDistances(x_coordinates, y_coordinates, z_coordinates,
+                                                                   query[0], query[1], query[2]);
+            index.FindNearestNeighbors(25, query[0], query[1], query[2], neighbors);
+            REQUIRE(neighbors.size() == 25);
+            for (size_t i = 0; i < neighbors.size(); i++) {
+                REQUIRE(neighbors[i].distance == distances[i]);
+            }
+        }
+    }
+
+    SECTION("Distance at rank") {
+        for (const auto& query : queries) {
+            std::vector<double> distances = ComputeSortedDistances(x_coordinates, y_coordinates, z_coordinates,
+                                                                   query[0], query[1], query[2]);
+            for (size_t rank : {0, 1, 250, 500, 750, 999}) {
+                REQUIRE(index.FindDistanceAtRank(rank, query[0], query[1], query[2]) == distances[rank]);
+            }
+        }
+    }
+
+    SECTION("Closest distance to target") {
+        for (const auto& query : queries) {
+            std::vector<double> distances = ComputeSortedDistances(x_coordinates, y_coordinates, z_coordinates,
+                                                                   query[0], query[1], query[2]);
+            for (double target : {0.0, 0.17, 0.4, 0.9, 5.0}) {
+                // Nearest distance to target in sorted order, preferring the smaller one on a tie
+                double expected = distances[0];
+                for (double distance : distances) {
+                    if (std::abs(distance - target) < std::abs(expected - target)) {
+                        expected = distance;
+                    }
+                }
+                finadvisor::MomentumNeighbor neighbor = index.FindClosestDistance(target, query[0], query[1],
+                                                                                  query[2]);
+                REQUIRE(neighbor.distance == expected);
+                REQUIRE(finadvisor::ComputeMomentumDistance(query[0] - x_coordinates[neighbor.point_index],
+                                                            query[1] - y_coordinates[neighbor.point_index],
+                                                            query[2] - z_coordinates[neighbor.point_index]) ==
+                        expected);
+            }
+        }
+    }
+
+    SECTION("Out of bounds queries") {
+        std::vector<finadvisor::MomentumNeighbor> neighbors;
+        REQUIRE_THROWS_AS(index.FindNearestNeighbors(1001, 0, 0, 0, neighbors), std::invalid_argument);
+        REQUIRE_THROWS_AS(index.FindDistanceAtRank(1000, 0, 0, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(finadvisor::MomentumPointIndex().FindClosestDistance(0, 0, 0, 0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("K nearest labels average through point index") {
+    finadvisor::MomentumModel model{};
+    // a, b, and c stand for price increase, price decrease, and static price characters respectively
+    for (const char* pattern : {"abc", "aab", "bcc", "abcabc", "ccc", "ab", "a", "bbbbbc", "cab", "acbc"}) {
+        string line;
+        for (const char* character = pattern; *character != '\0'; character++) {
+            line += finadvisor::kMomentumTrainingDataCharacters_[*character - 'a'];
+        }
+        model.SetFileLine(line);
+        model.GenerateMomentumPoint();
+    }
+    std::vector<double> distances;
+    for (size_t unique_index : model.GetPointUniqueIndices()) {
+        finadvisor::MomentumPoint point;
+        point.price_increase_probability = model.GetPriceIncreaseProbabilities()[unique_index];
+        point.price_decrease_probability = model.GetPriceDecreaseProbabilities()[unique_index];
+        point.static_price_probability = model.GetStaticPriceProbabilities()[unique_index];
+        distances.emplace_back(model.CalculateEuclideanDistance(point, 0.2, 0.3, 0.5));
+    }
+    std::sort(distances.begin(), distances.end());
+    double expected_average = 0;
+    for (size_t i = 0; i < 3; i++) {
+        expected_average += pow(distances[i] - distances[7] - distances[2], 2);
+    }
+
+    SECTION("Matches sorted distances") {
+        REQUIRE(model.ComputeKNearestLabelsAverage(3, 0.2, 0.3, 0.5) == expected_average / 3);
+    }
+
+    SECTION("Read-only query selects from momentum points generated after the index was built") {
+        const finadvisor::MomentumModel& read_only_model = model;
+        finadvisor::MomentumQueryScratch scratch;
+        REQUIRE(read_only_model.ComputeKNearestLabelsAverage(3, 0.2, 0.3, 0.5, scratch) == expected_average / 3);
+        model.ComputeKNearestLabelsAverage(3, 0.2, 0.3, 0.5);
+        REQUIRE(read_only_model.ComputeKNearestLabelsAverage(3, 0.2, 0.3, 0.5, scratch) == expected_average / 3);
+    }
+
+    SECTION("Momentum points keep their order") {
+        double first_probability = model.GetStaticPriceProbabilities()[0];
+        model.ComputeKNearestLabelsAverage(3, 0.2, 0.3, 0.5);
+        REQUIRE(model.GetStaticPriceProbabilities()[0] == first_probability);
+    }
+
+    SECTION("K exceeds momentum point count") {
+        REQUIRE_THROWS_AS(model.ComputeKNearestLabelsAverage(11, 0.2, 0.3, 0.5), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Concurrent read-only momentum queries") {
+    finadvisor::MomentumModel model{};
+    for (size_t point = 0; point < 500; point++) {
+        string line;
+        for (size_t day = 0; day < 5 + point % 17; day++) {
+            line += finadvisor::kMomentumTrainingDataCharacters_[(point * 7 + day * day) % 3];
+        }
+        model.SetFileLine(line);
+        model.GenerateMomentumPoint();
+    }
+    model.BuildPointIndex();
+    const finadvisor::MomentumModel& read_only_model = model;
+
+    std::vector<double> expected_averages(200);
+    std::vector<finadvisor::LabelId> expected_trends(200);
+    finadvisor::MomentumQueryScratch scratch;
+    for (size_t query = 0; query < expected_averages.size(); query++) {
+        double x = (query % 10) / 10.0;
+        double y = (query / 10) / 20.0;
+        expected_averages[query] = read_only_model.ComputeKNearestLabelsAverage(5, x, y, 1 - x - y, scratch);
+        expected_trends[query] = read_only_model.FindTrendIdAtDistance(expected_averages[query], x, y, 1 - x - y);
+    }
+
+    std::vector<double> averages(expected_averages.size());
+    std::vector<finadvisor::LabelId> trends(expected_trends.size());
+    finadvisor::ParallelFor(averages.size(), 4, [&](size_t query) {
+        finadvisor::MomentumQueryScratch thread_scratch;
+        double x = (query % 10) / 10.0;
+        double y = (query / 10) / 20.0;
+        averages[query] = read_only_model.ComputeKNearestLabelsAverage(5, x, y, 1 - x - y, thread_scratch);
+        trends[query] = read_only_model.FindTrendIdAtDistance(averages[query], x, y, 1 - x - y);
+    });
+    REQUIRE(averages == expected_averages);
+    REQUIRE(trends == expected_trends);
+}
+
+TEST_CASE("Weighted momentum point index matches expanded points") {
+    std::vector<double> x_coordinates;
+    std::vector<double> y_coordinates;
+    std::vector<double> z_coordinates;
+    GeneratePoints(300, x_coordinates, y_coordinates, z_coordinates);
+    std::vector<size_t> weights;
+    std::vector<double> expanded_x_coordinates;
+    std::vector<double> expanded_y_coordinates;
+    std::vector<double> expanded_z_coordinates;
+    for (size_t point = 0; point < x_coordinates.size(); point++) {
+        weights.emplace_back(1 + (point * 7) % 5);
+        for (size_t copy = 0; copy < weights.back(); copy++) {
+            expanded_x_coordinates.emplace_back(x_coordinates[point]);
+            expanded_y_coordinates.emplace_back(y_coordinates[point]);
+            expanded_z_coordinates.emplace_back(z_coordinates[point]);
+        }
+    }
+    finadvisor::MomentumPointIndex index(x_coordinates, y_coordinates, z_coordinates, weights);
+    REQUIRE(index.GetPointCount() == 300);
+    REQUIRE(index.GetTotalWeight() == expanded_x_coordinates.size());
+
+    for (const auto& query : std::vector<std::vector<double>>{{0.3, 0.2, 0.5}, {0.05, 0.9, 0.05}}) {
+        std::vector<double> distances = ComputeSortedDistances(expanded_x_coordinates, expanded_y_coordinates,
+                                                               expanded_z_coordinates, query[0], query[1], query[2]);
+
+        SECTION("K nearest neighbors") {
+            std::vector<finadvisor::MomentumNeighbor> neighbors;
+            index.FindNearestNeighbors(40, query[0], query[1], query[2], neighbors);
+            std::vector<double> neighbor_distances;
+            for (const finadvisor::MomentumNeighbor& neighbor : neighbors) {
+                neighbor_distances.insert(neighbor_distances.end(), neighbor.weight, neighbor.distance);
+            }
+            REQUIRE(neighbor_distances == std::vector<double>(distances.begin(), distances.begin() + 40));
+        }
+
+        SECTION("Distance at rank") {
+            for (size_t rank : {size_t(0), distances.size() / 4, distances.size() * 3 / 4, distances.size() - 1}) {
+                REQUIRE(index.FindDistanceAtRank(rank, query[0], query[1], query[2]) == distances[rank]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Momentum model collapses identical momentum points") {
+    finadvisor::MomentumModel model{};
+    // Repeating one line drives every probability to a fixed point, after which momentum points repeat exactly
+    string line = finadvisor::kMomentumTrainingDataCharacters_.substr(0, 1) +
+                  finadvisor::kMomentumTrainingDataCharacters_.substr(2, 1);
+    for (size_t point = 0; point < 1200; point++) {
+        model.SetFileLine(line);
+        model.GenerateMomentumPoint();
+    }
+    model.BuildPointIndex();
+    REQUIRE(model.GetMomentumPointCount() == 1200);
+    REQUIRE(model.GetUniquePointCount() < 1200);
+    REQUIRE(model.GetPointMultiplicities().size() == model.GetUniquePointCount());
+    size_t multiplicity_sum = 0;
+    for (size_t multiplicity : model.GetPointMultiplicities()) {
+        multiplicity_sum += multiplicity;
+    }
+    REQUIRE(multiplicity_sum == 1200);
+
+    // Distance of the momentum point generated at a position, read through the unique point views
+    auto compute_distance = [&model](size_t point) {
+        size_t unique_index = model.GetPointUniqueIndices()[point];
+        return finadvisor::ComputeMomentumDistance(0.4 - model.GetPriceIncreaseProbabilities()[unique_index],
+                                                   0.1 - model.GetPriceDecreaseProbabilities()[unique_index],
+                                                   0.5 - model.GetStaticPriceProbabilities()[unique_index]);
+    };
+    std::vector<double> distances;
+    for (size_t i = 0; i < model.GetMomentumPointCount(); i++) {
+        distances.emplace_back(compute_distance(i));
+    }
+    std::sort(distances.begin(), distances.end());
+    double expected_average = 0;
+    for (size_t i = 0; i < 200; i++) {
+        expected_average += pow(distances[i] - distances[900] - distances[300], 2);
+    }
+    REQUIRE(model.ComputeKNearestLabelsAverage(200, 0.4, 0.1, 0.5) == expected_average / 200);
+    // Momentum points generated after the index was built are answered by selection over unique points
+    model.SetFileLine(line);
+    model.GenerateMomentumPoint();
+    const finadvisor::MomentumModel& read_only_model = model;
+    finadvisor::MomentumQueryScratch scratch;
+    distances.emplace_back(compute_distance(1200));
+    std::sort(distances.begin(), distances.end());
+    expected_average = 0;
+    for (size_t i = 0; i < 200; i++) {
+        expected_average += pow(distances[i] - distances[900] - distances[300], 2);
+    }
+    REQUIRE(read_only_model.ComputeKNearestLabelsAverage(200, 0.4, 0.1, 0.5, scratch) == expected_average / 200);
+}
@@ -33,36 +33,48 @@ TEST_CASE("Overload of Extraction Operator for Momentum Training Data Factory")
     std::vector<std::string> file_paths = {"stock_data.csv"};
     factory = factory.ValidateFiles(file_paths);
 
-    // Call to ValidateFiles invokes extraction operator
-    SECTION("Momentum of first map element") {
+    // Months are ordered chronologically, so the first month is April 2009
+    SECTION("Momentum of first month") {
         REQUIRE(factory.GetMomentum(0).category == finadvisor::MomentumCategory::Bearish);
-        REQUIRE(factory.GetMomentum(0).direction == finadvisor::MomentumDirection::Reversal);
+        REQUIRE(factory.GetMomentum(0).direction == finadvisor::MomentumDirection::Continuation);
     }
 
-    SECTION("Momentum of middle map element") {
-        REQUIRE(static_cast<int>(factory.GetMomentum(5).category) == 0);
+    SECTION("Momentum of middle month") {
+        REQUIRE(static_cast<int>(factory.GetMomentum(5).category) == 1);
         REQUIRE(static_cast<int>(factory.GetMomentum(5).direction) == 1);
     }
 
-    SECTION("Momentum of last map element") {
+    SECTION("Momentum of last month") {
         REQUIRE(static_cast<int>(factory.GetMomentum(10).category) == 0);
         REQUIRE(static_cast<int>(factory.GetMomentum(10).direction) == 0);
     }
 
-    SECTION("Price Differences of first map element") {
-        // Check index within price differences vector to find price difference
-        std::vector<double> price_differences = {0.54, 0.345, -0.456, 0.55};
-        REQUIRE(Approx(factory.GetPriceDifferences(0)[0]) == -0.47);
+    SECTION("Price Differences of first month") {
+        // Opening price minus closing price of 2009-04-01
+        REQUIRE(Approx(factory.GetPriceDifferences(0)[0]) == 0.09);
     }
 
-    SECTION("Price Differences of middle map element") {
-        std::vector<double> price_differences = {-0.24, -0.355, 0.87, 0.97, 0.65, 0.74, -0.87};
-        REQUIRE(Approx(factory.GetPriceDifferences(5)[3]).margin(0.01) == 0.1);
+    SECTION("Price Differences of middle month") {
+        REQUIRE(Approx(factory.GetPriceDifferences(5)[3]).margin(0.01) == 0.08);
     }
 
-    SECTION("Price Differences of last map element") {
-        std::vector<double> price_differences = {-0.34, 0.67, 0.54};
-        REQUIRE(Approx(factory.GetPriceDifferences(10)[2]).margin(0.01) == 0.15);
+    SECTION("Price Differences of last month") {
+        REQUIRE(Approx(factory.GetPriceDifferences(10)[2]).margin(0.01) == 0.3);
+    }
+
+    SECTION("Index out of bounds") {
+        REQUIRE_THROWS_AS(factory.GetMomentum(factory.GetMonthCount()), std::invalid_argument);
+    }
+
+    SECTION("Find month by year and month") {
+        REQUIRE(factory.FindMonth(0, 2009, 4) == 0);
+        REQUIRE(factory.FindMonth(0, 2009, 9) == 5);
+        REQUIRE(factory.GetPriceDifferences(factory.FindMonth(0, 2010, 2)) == factory.GetPriceDifferences(10));
+    }
+
+    SECTION("Find month that does not exist") {
+        REQUIRE_THROWS_AS(factory.FindMonth(0, 2009, 3), std::invalid_argument);
+        REQUIRE_THROWS_AS(factory.FindMonth(1, 2009, 4), std::invalid_argument);
     }
 }
 
@@ -74,7 +86,7 @@ TEST_CASE("Overload of insertion operator for Momentum Training Data Factory") {
     stream << factory;
 
     SECTION("Momentum Label of First Line") {
-        REQUIRE(stream.str().substr(0, 16) == "Bearish Reversal");
+        REQUIRE(stream.str().substr(0, 20) == "Bearish Continuation");
     }
 
 
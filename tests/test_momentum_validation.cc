@@ -0,0 +1,167 @@
+#include <catch2/catch.hpp>
+#include "core/momentum-prediction/momentum_classifier.h"
+#include "core/momentum-prediction/momentum_model.h"
+#include <cmath>
+#include <random>
+#include <sstream>
+
+namespace {
+
+const char* const kTrends[] = {"Bullish Reversal", "Bearish Reversal", "Bullish Continuation",
+                               "Bearish Continuation"};
+
+/**
+ * Writes a model file of labeled months, each month a line of up to 23 trading day characters.
+ */
+string GenerateModelFile(size_t month_count, unsigned seed) {
+    std::vector<string> unicode_characters = {"0x7ff84393afe0", "0x7faad7c3e4d0", "0x7ffee0aaaffc"};
+    std::mt19937 generator(seed);
+    std::stringstream file;
+    for (size_t month = 0; month < month_count; month++) {
+        file << kTrends[generator() % 4] << "\n";
+        size_t day_count = 15 + generator() % 9;
+        for (size_t day = 0; day < day_count; day++) {
+            file << unicode_characters[generator() % 3] << ",";
+        }
+        file << "\n";
+    }
+    return file.str();
+}
+
+/**
+ * Writes a file of labeled testing points in the format read by MomentumClassifier.
+ */
+string GenerateTestingFile(size_t point_count, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::stringstream file;
+    for (size_t point = 0; point < point_count; point++) {
+        file << kTrends[generator() % 4] << "\n";
+        double x = (generator() % 21) / 20.0;
+        double y = (1 - x) * (generator() % 11) / 10.0;
+        file << x << " " << y << " " << 1 - x - y << "\n";
+    }
+    return file.str();
+}
+
+}
+
+TEST_CASE("Batched momentum validation accuracy") {
+    finadvisor::MomentumModel model{};
+    std::stringstream model_file(GenerateModelFile(400, 3));
+    model_file >> model;
+    finadvisor::MomentumClassifier classifier;
+    std::stringstream testing_file(GenerateTestingFile(300, 5));
+    testing_file >> classifier;
+
+    // Scores every testing point one at a time
+    auto compute_serial_accuracy = [&](size_t k) {
+        double correct_count = 0;
+        for (size_t i = 0; i < 300; i++) {
+            finadvisor::MomentumPoint point = classifier.GetMomentumTestingPoint(i);
+            double average = model.ComputeKNearestLabelsAverage(k, point.price_increase_probability,
+                                                                point.price_decrease_probability,
+                                                                point.static_price_probability);
+            finadvisor::LabelId trend = finadvisor::kNoLabel_;
+            if (!std::isnan(average)) {
+                trend = model.FindTrendIdAtDistance(average, point.price_increase_probability,
+                                                    point.price_decrease_probability, point.static_price_probability);
+            }
+            if (trend == point.momentum_trend) {
+                correct_count++;
+            }
+        }
+        return correct_count / 300;
+    };
+
+    SECTION("Matches serial scoring") {
+        for (size_t k : {1, 5, 20}) {
+            double accuracy = classifier.CalculateValidationAccuracy(model, k);
+            REQUIRE(accuracy == compute_serial_accuracy(k));
+            REQUIRE(accuracy > 0);
+        }
+    }
+
+    SECTION("Independent of thread count") {
+        classifier.SetThreadCount(1);
+        double single_thread_accuracy = classifier.CalculateValidationAccuracy(model, 5);
+        classifier.SetThreadCount(4);
+        REQUIRE(classifier.CalculateValidationAccuracy(model, 5) == single_thread_accuracy);
+    }
+
+    SECTION("Accuracy curve matches one pass per k") {
+        std::vector<double> accuracies = classifier.CalculateValidationAccuracyCurve(model, 0, 30);
+        REQUIRE(accuracies.size() == 31);
+        for (size_t k = 0; k <= 30; k++) {
+            REQUIRE(accuracies[k] == classifier.CalculateValidationAccuracy(model, k));
+        }
+        std::vector<double> partial_accuracies = classifier.CalculateValidationAccuracyCurve(model, 12, 15);
+        REQUIRE(partial_accuracies == std::vector<double>(accuracies.begin() + 12, accuracies.begin() + 16));
+        REQUIRE_THROWS_AS(classifier.CalculateValidationAccuracyCurve(model, 6, 5), std::invalid_argument);
+    }
+
+    SECTION("Prediction curve matches predictions for each k") {
+        finadvisor::MomentumQueryScratch scratch;
+        std::vector<finadvisor::MomentumPrediction> predictions;
+        model.PredictMomentumCurve(50, 0.4, 0.35, 0.25, scratch, predictions);
+        REQUIRE(predictions.size() == 51);
+        REQUIRE(std::isnan(predictions[0].k_nearest_labels_average));
+        for (size_t k = 0; k <= 50; k++) {
+            finadvisor::MomentumPrediction prediction = model.PredictMomentum(k, 0.4, 0.35, 0.25, scratch);
+            if (k > 0) {
+                REQUIRE(predictions[k].k_nearest_labels_average == prediction.k_nearest_labels_average);
+            }
+            REQUIRE(predictions[k].trend_id == prediction.trend_id);
+        }
+    }
+
+    SECTION("K value is 0") {
+        // No momentum point matches, so no testing point is predicted correctly
+        REQUIRE(classifier.CalculateValidationAccuracy(model, 0) == 0);
+    }
+}
+
+TEST_CASE("Momentum inference table") {
+    finadvisor::MomentumModel model{};
+    std::stringstream model_file(GenerateModelFile(400, 11));
+    model_file >> model;
+    finadvisor::MomentumModel table_model = model;
+    table_model.BuildInferenceTable(5, 23);
+    finadvisor::MomentumQueryScratch scratch;
+
+    SECTION("Lattice points match regular search") {
+        for (size_t day_count : {1, 2, 7, 20, 23}) {
+            for (size_t increase_count = 0; increase_count <= day_count; increase_count++) {
+                for (size_t decrease_count = 0; increase_count + decrease_count <= day_count; decrease_count++) {
+                    double x = static_cast<double>(increase_count) / day_count;
+                    double y = static_cast<double>(decrease_count) / day_count;
+                    double z = static_cast<double>(day_count - increase_count - decrease_count) / day_count;
+                    finadvisor::MomentumPrediction expected = model.PredictMomentum(5, x, y, z, scratch);
+                    finadvisor::MomentumPrediction prediction = table_model.PredictMomentum(5, x, y, z, scratch);
+                    REQUIRE(prediction.k_nearest_labels_average == expected.k_nearest_labels_average);
+                    REQUIRE(prediction.trend_id == expected.trend_id);
+                }
+            }
+        }
+    }
+
+    SECTION("Off-lattice points and other k fall back to regular search") {
+        for (const auto& query : std::vector<std::vector<double>>{{0.123, 0.456, 0.421}, {1.0 / 24, 0, 23.0 / 24},
+                                                                  {0.5, 0.5, 0.1}}) {
+            finadvisor::MomentumPrediction expected = model.PredictMomentum(5, query[0], query[1], query[2], scratch);
+            finadvisor::MomentumPrediction prediction = table_model.PredictMomentum(5, query[0], query[1], query[2],
+                                                                                     scratch);
+            REQUIRE(prediction.k_nearest_labels_average == expected.k_nearest_labels_average);
+        }
+        REQUIRE(table_model.PredictMomentum(3, 0.5, 0.25, 0.25, scratch).k_nearest_labels_average ==
+                model.PredictMomentum(3, 0.5, 0.25, 0.25, scratch).k_nearest_labels_average);
+    }
+
+    SECTION("Validation accuracy is unchanged") {
+        finadvisor::MomentumClassifier classifier;
+        std::stringstream testing_file(GenerateTestingFile(300, 13));
+        testing_file >> classifier;
+        REQUIRE(table_model.PredictMomentum(0, 0.5, 0.5, 0, scratch).trend_id == finadvisor::kNoLabel_);
+        REQUIRE(classifier.CalculateValidationAccuracy(table_model, 5) ==
+                classifier.CalculateValidationAccuracy(model, 5));
+    }
+}
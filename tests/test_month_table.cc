@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+#include "core/month_table.h"
+#include "core/date.h"
+
+TEST_CASE("Month table keeps months in insertion order") {
+    finadvisor::MonthTable<int> table;
+    table.Append(0, Date("2020-01-15").GetMonthKey(), {1.0, 2.0}, 10);
+    table.Append(0, Date("2020-03-02").GetMonthKey(), {3.0}, 30);
+    table.Append(1, Date("2019-12-31").GetMonthKey(), {4.0, 5.0, 6.0}, 40);
+
+    SECTION("Labels and values by index") {
+        REQUIRE(table.GetMonthCount() == 3);
+        REQUIRE(table.GetLabel(1) == 30);
+        REQUIRE(table.GetValues(0) == std::vector<double>({1.0, 2.0}));
+        REQUIRE(table.GetValues(2) == std::vector<double>({4.0, 5.0, 6.0}));
+        REQUIRE(table.GetValuesEnd(1) - table.GetValuesBegin(1) == 1);
+        REQUIRE(table.GetSymbolIndex(2) == 1);
+    }
+
+    SECTION("Identical values do not collide") {
+        table.Append(1, Date("2020-01-02").GetMonthKey(), {1.0, 2.0}, 10);
+        REQUIRE(table.GetMonthCount() == 4);
+    }
+
+    SECTION("Index out of bounds") {
+        REQUIRE_THROWS_AS(table.GetLabel(3), std::invalid_argument);
+        REQUIRE_THROWS_AS(table.GetValues(3), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Month table finds months by symbol, year and month") {
+    finadvisor::MonthTable<int> table;
+    table.Append(0, Date("2020-01-15").GetMonthKey(), {1.0}, 10);
+    table.Append(0, Date("2020-03-02").GetMonthKey(), {3.0}, 30);
+    table.Append(1, Date("2019-12-31").GetMonthKey(), {4.0}, 40);
+
+    SECTION("Existing months") {
+        REQUIRE(table.FindMonth(0, 2020, 1) == 0);
+        REQUIRE(table.FindMonth(0, 2020, 3) == 1);
+        REQUIRE(table.FindMonth(1, 2019, 12) == 2);
+    }
+
+    SECTION("Gap between months") {
+        REQUIRE_THROWS_AS(table.FindMonth(0, 2020, 2), std::invalid_argument);
+    }
+
+    SECTION("Months outside range of symbol") {
+        REQUIRE_THROWS_AS(table.FindMonth(0, 2019, 12), std::invalid_argument);
+        REQUIRE_THROWS_AS(table.FindMonth(1, 2020, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(table.FindMonth(2, 2020, 1), std::invalid_argument);
+    }
+
+    SECTION("Months appended out of order") {
+        table.Append(0, Date("2019-11-20").GetMonthKey(), {5.0}, 50);
+        REQUIRE(table.FindMonth(0, 2019, 11) == 3);
+        REQUIRE(table.FindMonth(0, 2020, 3) == 1);
+    }
+
+    SECTION("Appended table keeps symbol indices") {
+        finadvisor::MonthTable<int> merged_table;
+        merged_table.AppendTable(table);
+        REQUIRE(merged_table.GetMonthCount() == 3);
+        REQUIRE(merged_table.FindMonth(1, 2019, 12) == 2);
+        REQUIRE(merged_table.GetValues(1) == std::vector<double>({3.0}));
+    }
+}
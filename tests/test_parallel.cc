@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+#include "core/parallel.h"
+#include "core/momentum-prediction/momentum_training_data_factory.h"
+#include "core/volatility-prediction/volatility_training_data_factory.h"
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Parallel for loop") {
+    SECTION("Every task runs exactly once") {
+        std::vector<int> run_counts(1000, 0);
+        finadvisor::ParallelFor(run_counts.size(), 4, [&](size_t i) { run_counts[i]++; });
+        for (int run_count : run_counts) {
+            REQUIRE(run_count == 1);
+        }
+    }
+
+    SECTION("No tasks") {
+        finadvisor::ParallelFor(0, 4, [](size_t) { throw std::logic_error("Task should not run"); });
+    }
+
+    SECTION("Exception of lowest failing task is rethrown") {
+        REQUIRE_THROWS_WITH(finadvisor::ParallelFor(100, 4, [](size_t i) {
+            if (i >= 10) {
+                throw std::invalid_argument(std::to_string(i));
+            }
+        }), "10");
+    }
+}
+
+TEST_CASE("Training data is identical for any thread count") {
+    std::vector<std::string> file_paths = {"stock_data.csv", "abengoa.csv", "acciona.csv", "stock_data.csv"};
+
+    SECTION("Momentum training data") {
+        finadvisor::MomentumTrainingDataFactory serial_factory;
+        serial_factory.SetThreadCount(1);
+        serial_factory = serial_factory.ValidateFiles(file_paths);
+        for (size_t thread_count : {2, 3, 8}) {
+            finadvisor::MomentumTrainingDataFactory parallel_factory;
+            parallel_factory.SetThreadCount(thread_count);
+            parallel_factory = parallel_factory.ValidateFiles(file_paths);
+            REQUIRE(parallel_factory.GetMonthCount() == serial_factory.GetMonthCount());
+            for (size_t i = 0; i < serial_factory.GetMonthCount(); i++) {
+                REQUIRE(parallel_factory.GetPriceDifferences(i) == serial_factory.GetPriceDifferences(i));
+                REQUIRE(parallel_factory.GetMomentum(i).category == serial_factory.GetMomentum(i).category);
+                REQUIRE(parallel_factory.GetMomentum(i).direction == serial_factory.GetMomentum(i).direction);
+            }
+        }
+    }
+
+    SECTION("Volatility training data") {
+        finadvisor::VolatilityTrainingDataFactory serial_factory;
+        serial_factory.SetThreadCount(1);
+        serial_factory = serial_factory.ValidateFiles(file_paths);
+        for (size_t thread_count : {2, 3, 8}) {
+            finadvisor::VolatilityTrainingDataFactory parallel_factory;
+            parallel_factory.SetThreadCount(thread_count);
+            parallel_factory = parallel_factory.ValidateFiles(file_paths);
+            REQUIRE(parallel_factory.GetMonthCount() == serial_factory.GetMonthCount());
+            for (size_t i = 0; i < serial_factory.GetMonthCount(); i++) {
+                REQUIRE(parallel_factory.GetStandardizedQuartilePrices(i) ==
+                        serial_factory.GetStandardizedQuartilePrices(i));
+                REQUIRE(parallel_factory.GetVolatility(i).measure == serial_factory.GetVolatility(i).measure);
+                REQUIRE(parallel_factory.GetVolatility(i).category == serial_factory.GetVolatility(i).category);
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+#include "core/price_cache.h"
+#include "core/price_store.h"
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+void WriteCsvFile(const std::string& file_path, const std::string& contents) {
+    std::ofstream file(file_path);
+    file << contents;
+}
+
+}
+
+TEST_CASE("Binary cache of price series") {
+    std::string file_path = "price_cache_test_data.csv";
+    std::remove(finadvisor::PriceCache::GetCachePath(file_path).c_str());
+    WriteCsvFile(file_path, "2009-04-01,3.08,3.1,2.99,2.99,100\n2009-04-02,3.29,3.3,3.13,3.13,200\n");
+
+    SECTION("Missing cache is not read") {
+        finadvisor::PriceSeries series;
+        REQUIRE_FALSE(finadvisor::PriceCache::Read(file_path, series));
+    }
+
+    SECTION("Cached series matches parsed series") {
+        finadvisor::PriceSeries parsed_series = finadvisor::PriceStore::ParseSeries(file_path);
+        REQUIRE(finadvisor::PriceCache::Write(file_path, parsed_series));
+        finadvisor::PriceSeries cached_series;
+        REQUIRE(finadvisor::PriceCache::Read(file_path, cached_series));
+        REQUIRE(cached_series.GetDayCount() == 2);
+        REQUIRE(cached_series.dates[1].GetYear() == 2009);
+        REQUIRE(cached_series.dates[1].GetMonth() == 4);
+        REQUIRE(cached_series.dates[1].GetDay() == 2);
+        REQUIRE(cached_series.opening_prices == parsed_series.opening_prices);
+        REQUIRE(cached_series.high_prices == parsed_series.high_prices);
+        REQUIRE(cached_series.low_prices == parsed_series.low_prices);
+        REQUIRE(cached_series.closing_prices == parsed_series.closing_prices);
+        REQUIRE(cached_series.volumes == parsed_series.volumes);
+    }
+
+    SECTION("Cache is stale once csv file changes") {
+        finadvisor::PriceStore store;
+        store.SetUseBinaryCache(true);
+        store = store.ValidateFiles({file_path});
+        WriteCsvFile(file_path, "2009-04-01,3.08,3.1,2.99,2.99,100\n");
+        finadvisor::PriceSeries series;
+        REQUIRE_FALSE(finadvisor::PriceCache::Read(file_path, series));
+        store = store.ValidateFiles({file_path});
+        REQUIRE(store.GetSeries(0).GetDayCount() == 1);
+        REQUIRE(finadvisor::PriceCache::Read(file_path, series));
+    }
+
+    SECTION("Corrupted cache is not read") {
+        finadvisor::PriceStore store;
+        store.SetUseBinaryCache(true);
+        store = store.ValidateFiles({file_path});
+        std::fstream cache(finadvisor::PriceCache::GetCachePath(file_path),
+                           std::ios::in | std::ios::out | std::ios::binary);
+        cache.seekp(-1, std::ios::end);
+        cache.put('\x7f');
+        cache.close();
+        finadvisor::PriceSeries series;
+        REQUIRE_FALSE(finadvisor::PriceCache::Read(file_path, series));
+    }
+
+    std::remove(finadvisor::PriceCache::GetCachePath(file_path).c_str());
+    std::remove(file_path.c_str());
+}
+
+TEST_CASE("Binary cache is opt in") {
+    std::string file_path = "price_cache_opt_in_test_data.csv";
+    std::remove(finadvisor::PriceCache::GetCachePath(file_path).c_str());
+    WriteCsvFile(file_path, "2009-04-01,3.08,3.1,2.99,2.99,100\n");
+
+    finadvisor::PriceStore store;
+    store = store.ValidateFiles({file_path});
+    REQUIRE(store.GetSeries(0).GetDayCount() == 1);
+    std::ifstream cache(finadvisor::PriceCache::GetCachePath(file_path));
+    REQUIRE_FALSE(cache.good());
+
+    std::remove(file_path.c_str());
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+#include "core/price_kernels.h"
+#include "core/volatility-prediction/volatility_calculator.h"
+#include <cstring>
+
+namespace {
+
+// Bit-for-bit comparison, so that even a difference in the last place fails
+bool IsBitIdentical(double first, double second) {
+    return std::memcmp(&first, &second, sizeof(double)) == 0;
+}
+
+}
+
+TEST_CASE("Price difference kernel") {
+    finadvisor::PriceSeries series = finadvisor::PriceStore::ParseSeries("stock_data.csv");
+
+    SECTION("Matches scalar formula for whole series") {
+        std::vector<double> price_differences = finadvisor::ComputePriceDifferences(series);
+        REQUIRE(price_differences.size() == series.GetDayCount());
+        for (size_t day = 0; day < series.GetDayCount(); day++) {
+            REQUIRE(IsBitIdentical(price_differences[day], series.opening_prices[day] - series.closing_prices[day]));
+        }
+    }
+
+    SECTION("Lengths that are not a multiple of the vector width") {
+        for (size_t day_count = 0; day_count < 9; day_count++) {
+            std::vector<double> price_differences(day_count);
+            finadvisor::ComputePriceDifferences(series.opening_prices.data() + 1, series.closing_prices.data() + 1,
+                                                day_count, price_differences.data());
+            for (size_t day = 0; day < day_count; day++) {
+                REQUIRE(IsBitIdentical(price_differences[day],
+                                       series.opening_prices[day + 1] - series.closing_prices[day + 1]));
+            }
+        }
+    }
+}
+
+TEST_CASE("Quartile price kernel") {
+    finadvisor::PriceSeries series = finadvisor::PriceStore::ParseSeries("stock_data.csv");
+    finadvisor::VolatilityCalculator calculator;
+
+    SECTION("Matches VolatilityCalculator for whole series") {
+        std::vector<double> quartile_prices = finadvisor::ComputeQuartilePrices(series);
+        REQUIRE(quartile_prices.size() == series.GetDayCount());
+        for (size_t day = 0; day < series.GetDayCount(); day++) {
+            REQUIRE(IsBitIdentical(quartile_prices[day], calculator.CalculateQuartilePrice(
+                    series.opening_prices[day], series.closing_prices[day], series.high_prices[day],
+                    series.low_prices[day])));
+        }
+    }
+
+    SECTION("Lengths that are not a multiple of the vector width") {
+        for (size_t day_count = 0; day_count < 9; day_count++) {
+            std::vector<double> quartile_prices(day_count);
+            finadvisor::ComputeQuartilePrices(series.opening_prices.data() + 3, series.closing_prices.data() + 3,
+                                              series.high_prices.data() + 3, series.low_prices.data() + 3, day_count,
+                                              quartile_prices.data());
+            for (size_t day = 0; day < day_count; day++) {
+                REQUIRE(IsBitIdentical(quartile_prices[day], calculator.CalculateQuartilePrice(
+                        series.opening_prices[day + 3], series.closing_prices[day + 3], series.high_prices[day + 3],
+                        series.low_prices[day + 3])));
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+#include "core/price_store.h"
+#include "core/momentum-prediction/momentum_training_data_factory.h"
+#include "core/volatility-prediction/volatility_training_data_factory.h"
+#include <sstream>
+
+TEST_CASE("Validate Files for Price Store") {
+    finadvisor::PriceStore store;
+    std::vector<std::string> file_paths;
+
+    SECTION("Non-existent file") {
+        file_paths = {"fakefile.csv"};
+        REQUIRE_THROWS_AS(store.ValidateFiles(file_paths), std::invalid_argument);
+    }
+
+    SECTION("No files") {
+        REQUIRE(store.ValidateFiles(file_paths).GetSeriesCount() == 0);
+    }
+
+    SECTION("Invalid series index") {
+        REQUIRE_THROWS_AS(store.GetSeries(0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Columns of Price Store") {
+    finadvisor::PriceStore store;
+    std::vector<std::string> file_paths = {"stock_data.csv", "stock_data.csv"};
+    store = store.ValidateFiles(file_paths);
+
+    SECTION("One series per file") {
+        REQUIRE(store.GetSeriesCount() == 2);
+        REQUIRE(store.GetSeries(0).file_path == "stock_data.csv");
+    }
+
+    SECTION("Every column holds one value per trading day") {
+        const finadvisor::PriceSeries& series = store.GetSeries(0);
+        REQUIRE(series.GetDayCount() > 0);
+        REQUIRE(series.opening_prices.size() == series.GetDayCount());
+        REQUIRE(series.high_prices.size() == series.GetDayCount());
+        REQUIRE(series.low_prices.size() == series.GetDayCount());
+        REQUIRE(series.closing_prices.size() == series.GetDayCount());
+        REQUIRE(series.volumes.size() == series.GetDayCount());
+    }
+
+    SECTION("Values of first trading day") {
+        const finadvisor::PriceSeries& series = store.GetSeries(0);
+        REQUIRE(series.dates[0].GetYear() == 2009);
+        REQUIRE(series.dates[0].GetMonth() == 4);
+        REQUIRE(series.opening_prices[0] == 3.08);
+        REQUIRE(series.high_prices[0] == 3.08);
+        REQUIRE(series.low_prices[0] == 2.99);
+        REQUIRE(series.closing_prices[0] == 2.99);
+        REQUIRE(series.volumes[0] == 0);
+    }
+}
+
+TEST_CASE("Factories built from Price Store match factories built from files") {
+    std::vector<std::string> file_paths = {"stock_data.csv"};
+    finadvisor::PriceStore store;
+    store = store.ValidateFiles(file_paths);
+
+    SECTION("Momentum training data") {
+        finadvisor::MomentumTrainingDataFactory file_factory;
+        file_factory = file_factory.ValidateFiles(file_paths);
+        finadvisor::MomentumTrainingDataFactory store_factory;
+        store_factory = store_factory.LoadPriceStore(store);
+        REQUIRE(store_factory.GetPriceDifferences(0) == file_factory.GetPriceDifferences(0));
+        REQUIRE(store_factory.GetPriceDifferences(10) == file_factory.GetPriceDifferences(10));
+    }
+
+    SECTION("Volatility training data") {
+        finadvisor::VolatilityTrainingDataFactory file_factory;
+        file_factory = file_factory.ValidateFiles(file_paths);
+        finadvisor::VolatilityTrainingDataFactory store_factory;
+        store_factory = store_factory.LoadPriceStore(store);
+        REQUIRE(store_factory.GetStandardizedQuartilePrices(0) == file_factory.GetStandardizedQuartilePrices(0));
+        REQUIRE(store_factory.GetDailyPrice(3).high_price == file_factory.GetDailyPrice(3).high_price);
+    }
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch.hpp>
+#include "core/rolling_window.h"
+#include "core/momentum-prediction/momentum_calculator.h"
+#include "core/momentum-prediction/momentum_training_data_factory.h"
+#include "core/volatility-prediction/volatility_calculator.h"
+#include "core/volatility-prediction/volatility_training_data_factory.h"
+#include <numeric>
+
+TEST_CASE("Rolling window statistics") {
+    finadvisor::RollingWindow window(3);
+
+    SECTION("Window length of 0") {
+        REQUIRE_THROWS_AS(finadvisor::RollingWindow(0), std::invalid_argument);
+    }
+
+    SECTION("Window fills up before it slides") {
+        window.Add(1);
+        window.Add(-2);
+        REQUIRE_FALSE(window.IsFull());
+        REQUIRE(window.GetDayCount() == 2);
+        window.Add(4);
+        window.Add(8);
+        REQUIRE(window.IsFull());
+        REQUIRE(window.GetDayCount() == 3);
+    }
+
+    SECTION("Statistics of slid window") {
+        for (double value : {5.0, 1.0, -2.0, 4.0, 8.0}) {
+            window.Add(value);
+        }
+        // Window holds -2, 4, 8
+        REQUIRE(Approx(window.GetMean()) == 10.0 / 3.0);
+        REQUIRE(Approx(window.GetSquaredDeviationSum()) == 152.0 / 3.0);
+        REQUIRE(Approx(window.GetSlopeNumerator()) == 10.0);
+        REQUIRE(window.GetTotalGain() == 12.0);
+        REQUIRE(window.GetTotalLoss() == -2.0);
+        REQUIRE(window.GetPositiveCount() == 2);
+        REQUIRE(window.GetNegativeCount() == 1);
+    }
+
+    SECTION("Window of zeros is flat") {
+        for (double value : {0.3, -0.1, 0.0, 0.0, 0.0}) {
+            window.Add(value);
+        }
+        REQUIRE(window.GetSlopeNumerator() == 0.0);
+        REQUIRE(window.GetSquaredDeviationSum() == 0.0);
+        REQUIRE(window.GetTotalGain() == 0.0);
+        REQUIRE(window.GetTotalLoss() == 0.0);
+    }
+
+    SECTION("Flat window has no slope") {
+        finadvisor::MomentumCalculator calculator;
+        for (size_t day = 0; day < 10; day++) {
+            window.Add(0.1);
+            if (window.IsFull()) {
+                REQUIRE(window.GetSlopeNumerator() == 0);
+                REQUIRE(calculator.ClassifyMomentum(calculator.ComputeMomentumStatistics(window)).category ==
+                        finadvisor::MomentumCategory::Indecision);
+                REQUIRE(Approx(window.GetSquaredDeviationSum()).margin(1e-15) == 0.0);
+                REQUIRE(window.GetPositiveCount() == 3);
+            }
+        }
+        window.Add(0.2);
+        REQUIRE(Approx(window.GetSlopeNumerator()) == 0.1);
+        REQUIRE(Approx(window.GetMean()) == 0.4 / 3);
+    }
+
+    SECTION("Clear keeps window length") {
+        window.Add(1);
+        window.Clear();
+        REQUIRE(window.GetDayCount() == 0);
+        REQUIRE(window.GetWindowLength() == 3);
+    }
+}
+
+TEST_CASE("Rolling window matches recomputation of each window") {
+    finadvisor::MomentumCalculator momentum_calculator;
+    finadvisor::VolatilityCalculator volatility_calculator;
+    std::vector<double> price_differences;
+    std::vector<double> quartile_prices;
+    for (size_t day = 0; day < 500; day++) {
+        price_differences.emplace_back(std::sin(day * 0.37) + (day % 7) * 0.01);
+        // Prices far from 0 exercise the shifted sums of the window
+        quartile_prices.emplace_back(100 + 10 * price_differences.back());
+    }
+    const size_t window_length = 21;
+    finadvisor::RollingWindow price_difference_window(window_length);
+    finadvisor::RollingWindow quartile_price_window(window_length);
+
+    for (size_t day = 0; day < price_differences.size(); day++) {
+        price_difference_window.Add(price_differences[day]);
+        quartile_price_window.Add(quartile_prices[day]);
+        if (!price_difference_window.IsFull()) {
+            continue;
+        }
+        size_t first_day = day + 1 - window_length;
+        finadvisor::MomentumStatistics expected = momentum_calculator.ComputeMomentumStatistics(
+                price_differences.data() + first_day, window_length);
+        finadvisor::MomentumStatistics actual = momentum_calculator.ComputeMomentumStatistics(price_difference_window);
+        REQUIRE(Approx(actual.linear_regression_slope).margin(1e-9) == expected.linear_regression_slope);
+        REQUIRE(Approx(actual.relative_strength_index) == expected.relative_strength_index);
+
+        std::vector<double> window_prices(quartile_prices.begin() + first_day,
+                                          quartile_prices.begin() + first_day + window_length);
+        REQUIRE(Approx(quartile_price_window.GetSquaredDeviationSum()) ==
+                volatility_calculator.CalculatePriceVariance(window_prices));
+        REQUIRE(Approx(quartile_price_window.GetSlopeNumerator() /
+                       momentum_calculator.ComputeDayCountDeviation(window_length)).margin(1e-9) ==
+                momentum_calculator.ComputeLinearRegressionSlope(window_prices));
+        REQUIRE(volatility_calculator.IdentifyVolatility(quartile_price_window).measure ==
+                volatility_calculator.IdentifyVolatility(window_prices).measure);
+    }
+}
+
+TEST_CASE("Rolling window mode of training data factories") {
+    std::vector<std::string> file_paths = {"stock_data.csv"};
+    finadvisor::PriceStore store;
+    store = store.ValidateFiles(file_paths);
+    const finadvisor::PriceSeries& series = store.GetSeries(0);
+    const size_t window_length = 21;
+
+    SECTION("Disabled by default") {
+        finadvisor::MomentumTrainingDataFactory factory;
+        factory = factory.LoadPriceStore(store);
+        REQUIRE(factory.GetRollingWindowCount() == 0);
+    }
+
+    SECTION("One momentum label per trading day once window is full") {
+        finadvisor::MomentumTrainingDataFactory factory;
+        factory.SetRollingWindowLength(window_length);
+        factory = factory.LoadPriceStore(store);
+        REQUIRE(factory.GetRollingWindowCount() == series.GetDayCount() - window_length + 1);
+        REQUIRE(factory.GetRollingWindowEndDate(0) == series.dates[window_length - 1]);
+
+        finadvisor::MomentumCalculator calculator;
+        std::vector<double> price_differences(window_length);
+        for (size_t day = 0; day < window_length; day++) {
+            price_differences[day] = series.opening_prices[day] - series.closing_prices[day];
+        }
+        REQUIRE(factory.GetRollingMomentum(0).category == calculator.IdentifyMomentum(price_differences).category);
+        REQUIRE(factory.GetRollingMomentum(0).direction == calculator.IdentifyMomentum(price_differences).direction);
+        REQUIRE_THROWS_AS(factory.GetRollingMomentum(factory.GetRollingWindowCount()), std::invalid_argument);
+    }
+
+    SECTION("One volatility label per trading day once window is full") {
+        finadvisor::VolatilityTrainingDataFactory factory;
+        factory.SetRollingWindowLength(window_length);
+        factory = factory.LoadPriceStore(store);
+        REQUIRE(factory.GetRollingWindowCount() == series.GetDayCount() - window_length + 1);
+        REQUIRE(factory.GetRollingWindowEndDate(factory.GetRollingWindowCount() - 1) == series.dates.back());
+    }
+}
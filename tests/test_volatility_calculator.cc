@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 #include "core/volatility-prediction/volatility_calculator.h"
+#include <cmath>
 
 TEST_CASE("Standardized quartile prices") {
     finadvisor::VolatilityCalculator calculator;
@@ -75,6 +76,20 @@ TEST_CASE("Beta Risk Proportion") {
         REQUIRE(Approx(calculator.ComputeBetaRiskProportion(quartile_prices, 10)) == 6.0858061945);
     }
 
+    SECTION("Quartile prices far from 0") {
+        // Shifting every price leaves variance and slope unchanged, so the beta risk proportion must not move
+        quartile_prices = {3, 7, 5, 3, 10, 4, 8, 6, 2, 9, 5};
+        std::vector<double> shifted_quartile_prices;
+        for (double quartile_price : quartile_prices) {
+            shifted_quartile_prices.emplace_back(quartile_price + 1e8);
+        }
+        finadvisor::VolatilityStatistics statistics = calculator.ComputeVolatilityStatistics(
+                quartile_prices.data(), quartile_prices.size(), nullptr);
+        finadvisor::VolatilityStatistics shifted_statistics = calculator.ComputeVolatilityStatistics(
+                shifted_quartile_prices.data(), shifted_quartile_prices.size(), nullptr);
+        REQUIRE(Approx(shifted_statistics.beta_risk_proportion).epsilon(1e-12) == statistics.beta_risk_proportion);
+    }
+
 }
 
 TEST_CASE("Price variance") {
@@ -145,4 +160,47 @@ TEST_CASE("Volatility Categorization") {
         REQUIRE(static_cast<int>(calculator.IdentifyVolatility(quartile_prices).category) == 0);
         REQUIRE(static_cast<int>(calculator.IdentifyVolatility(quartile_prices).measure) == 2);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Fused volatility statistics") {
+    finadvisor::VolatilityCalculator calculator;
+    std::vector<double> quartile_prices = {2, 6, 4, 5, 3, 7, 1, 9, 8};
+    std::vector<double> standardized_quartile_prices(quartile_prices.size());
+
+    SECTION("Matches separate calculations") {
+        finadvisor::VolatilityStatistics statistics = calculator.ComputeVolatilityStatistics(
+                quartile_prices.data(), quartile_prices.size(), standardized_quartile_prices.data());
+        REQUIRE(Approx(statistics.price_variance) == 60.0);
+        REQUIRE(Approx(statistics.beta_risk_proportion) ==
+                calculator.ComputeBetaRiskProportion(quartile_prices, statistics.price_variance));
+        REQUIRE(statistics.volatility.category == finadvisor::VolatilityCategory::Implied);
+        REQUIRE(statistics.volatility.measure == finadvisor::VolatilityMeasure::High);
+        // Mean is 5 and standard deviation is sqrt(60 / 9)
+        REQUIRE(Approx(standardized_quartile_prices[0]) == -3 / std::sqrt(60.0 / 9));
+    }
+
+    SECTION("Prices far from 0 keep their precision") {
+        std::vector<double> large_quartile_prices;
+        for (double quartile_price : quartile_prices) {
+            large_quartile_prices.emplace_back(1e9 + quartile_price);
+        }
+        REQUIRE(Approx(calculator.CalculatePriceVariance(large_quartile_prices)) == 60.0);
+        REQUIRE(Approx(calculator.StandardizeQuartilePrices(large_quartile_prices)[0]) == -3 / std::sqrt(60.0 / 9));
+    }
+
+    SECTION("Batch of windows matches single windows") {
+        std::vector<size_t> window_bounds = {0, 4, 9};
+        std::vector<double> batch_standardized_quartile_prices;
+        std::vector<finadvisor::VolatilityStatistics> statistics = calculator.ComputeVolatilityStatistics(
+                quartile_prices, window_bounds, batch_standardized_quartile_prices);
+        REQUIRE(statistics.size() == 2);
+        std::vector<double> second_window(quartile_prices.begin() + 4, quartile_prices.end());
+        REQUIRE(statistics[1].price_variance == calculator.CalculatePriceVariance(second_window));
+        REQUIRE(batch_standardized_quartile_prices[4] == calculator.StandardizeQuartilePrices(second_window)[0]);
+    }
+
+    SECTION("Window past end of quartile prices") {
+        std::vector<size_t> window_bounds = {0, 10};
+        REQUIRE_THROWS_AS(calculator.ComputeVolatilityStatistics(quartile_prices, window_bounds,
+                                                                 standardized_quartile_prices), std::invalid_argument);
+    }
+}
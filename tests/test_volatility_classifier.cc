@@ -1,32 +1,77 @@
 #include <catch2/catch.hpp>
 #include "core/volatility-prediction/volatility_model.h"
-#include "core/volatility-prediction/volatility_training_data_factory.h"
 #include "core/volatility-prediction/volatility_classifier.h"
+#include <sstream>
+
+namespace {
+
+/**
+ * Writes volatility training data of two volatility types, the first with lines of 2 z-scores and the second with
+ * lines of 10 z-scores.
+ */
+std::string GenerateVolatilityFile(size_t line_count) {
+    std::stringstream file;
+    const char* volatility_types[] = {"High Implied", "Low Historical"};
+    size_t line_lengths[] = {2, 10};
+    for (size_t type = 0; type < 2; type++) {
+        file << volatility_types[type] << "\n";
+        for (size_t line = 0; line < line_count; line++) {
+            for (size_t z_score = 0; z_score < line_lengths[type]; z_score++) {
+                file << "0x0000002D,";
+            }
+            file << "\n";
+        }
+    }
+    return file.str();
+}
+
+}
 
 TEST_CASE("Volatility Validation Accuracy") {
-    std::string directory_path = "../trainingdata";
-    vector<string> file_paths;
-    file_paths.resize(20);
-    for (const auto& file : std::filesystem::directory_iterator(directory_path)) {
-        file_paths.emplace_back(file);
-    }
-    vector<string> file_paths = {"abengoa.csv", "acciona.csv", "acerinox.csv", "acs.csv", "atresmedia.csv",
-                                 "banco-sabadell.csv", "bankinter.csv", "bbva.csv", "bme.csv", "caixabank.csv",
-                                 "colonial.csv", "enags.csv", "fcc.csv", "ferrovial.csv", "grifols.csv", "iberdrola.csv",
-                                 "inditex.csv", "indra.csv", "mapfre.csv", "mediaset.csv"};
-    finadvisor::VolatilityTrainingDataFactory factory;
-    factory = factory.ValidateFiles(file_paths);
-    finadvisor::VolatilityModel model;
-    model.ValidateFile(factory.WriteToOutputFile(factory));
+    finadvisor::VolatilityModel model{};
+    std::stringstream model_file(GenerateVolatilityFile(100));
+    model_file >> model;
+    // Volatility points accumulate across lines, so those of each type converge to a point set by their line length
+    std::stringstream testing_file;
+    testing_file << "High Implied\n";
+    for (size_t point = 0; point < 100; point++) {
+        testing_file << "0 2\n";
+    }
+    testing_file << "Low Historical\n";
+    for (size_t point = 0; point < 100; point++) {
+        testing_file << "0 " << 10.0 / 9 << "\n";
+    }
+    // Mislabeled on purpose, so accuracy falls below 1
+    testing_file << "Medium Implied\n";
+    for (size_t point = 0; point < 50; point++) {
+        testing_file << "0 2\n";
+    }
     finadvisor::VolatilityClassifier classifier;
-    classifier = classifier.ValidateFile("testvolatilitydata.txt");
-    REQUIRE(classifier.CalculateValidationAccuracy(model, 5) >= 0.7);
+    testing_file >> classifier;
+
+    SECTION("Untrained model cannot be validated") {
+        REQUIRE_THROWS_AS(classifier.CalculateValidationAccuracy(model), std::invalid_argument);
+    }
+
+    SECTION("Fraction of volatility testing points predicted correctly") {
+        model.Train(5);
+        REQUIRE(classifier.CalculateValidationAccuracy(model) == Approx(0.8));
+    }
 }
 
 TEST_CASE("Overload of volatility classifier extraction operator") {
     finadvisor::VolatilityClassifier classifier;
-    // Call to ValidateFile invokes extraction operator
-    classifier = classifier.ValidateFile("sample_volatility_testing_data.txt");
+    std::stringstream testing_file;
+    testing_file << "Low Implied\n0.3957946 0.6042054\n";
+    for (size_t point = 1; point < 682; point++) {
+        testing_file << "0.5 0.5\n";
+    }
+    testing_file << "High Historical\n0.73495563 0.26504437\n";
+    testing_file >> classifier;
+
+    SECTION("Missing file") {
+        REQUIRE_THROWS_AS(classifier.ValidateFile("missing_volatility_testing_data.txt"), std::invalid_argument);
+    }
 
     SECTION("Positive z score probability of first volatility testing point") {
         REQUIRE(classifier.GetVolatilityTestingPoint(0).positive_z_score_probability == 0.3957946);
@@ -37,7 +82,8 @@ TEST_CASE("Overload of volatility classifier extraction operator") {
     }
 
     SECTION("Volatility Type of first volatility testing point") {
-        REQUIRE(classifier.GetVolatilityTestingPoint(0).volatility_type == "Low Implied");
+        REQUIRE(classifier.GetVolatilityTestingPoint(0).volatility_type ==
+                finadvisor::ParseVolatilityType("Low Implied"));
     }
 
     SECTION("Positive z score probability of last volatility testing point") {
@@ -49,7 +95,8 @@ TEST_CASE("Overload of volatility classifier extraction operator") {
     }
 
     SECTION("Volatility Type of last volatility testing point") {
-        REQUIRE(classifier.GetVolatilityTestingPoint(682).volatility_type == "High Historical");
+        REQUIRE(classifier.GetVolatilityTestingPoint(682).volatility_type ==
+                finadvisor::ParseVolatilityType("High Historical"));
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,602 @@
+#include <catch2/catch.hpp>
+#include "core/volatility-prediction/volatility_classifier.h"
+#include "core/volatility-prediction/volatility_clustering.h"
+#include "core/volatility-prediction/volatility_model.h"
+#include <cmath>
+#include <float.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+/**
+ * Writes volatility training data of two volatility types, the first with lines of 2 z-scores and the second with
+ * lines of 10 z-scores.
+ */
+std::string GenerateVolatilityFile(size_t line_count) {
+    std::stringstream file;
+    const char* volatility_types[] = {"High Implied", "Low Historical"};
+    size_t line_lengths[] = {2, 10};
+    for (size_t type = 0; type < 2; type++) {
+        file << volatility_types[type] << "\n";
+        for (size_t line = 0; line < line_count; line++) {
+            for (size_t z_score = 0; z_score < line_lengths[type]; z_score++) {
+                file << "0x0000002D,";
+            }
+            file << "\n";
+        }
+    }
+    return file.str();
+}
+
+}
+
+TEST_CASE("Volatility model collapses identical volatility points") {
+    finadvisor::VolatilityModel model{};
+    // Repeating one line drives both probabilities to a fixed point, after which volatility points repeat exactly
+    for (size_t point = 0; point < 200; point++) {
+        model.SetFileLine("+-");
+        model.GenerateVolatilityPoint();
+    }
+
+    SECTION("Unique points and multiplicities") {
+        REQUIRE(model.GetVolatilityPointCount() == 200);
+        REQUIRE(model.GetUniquePointCount() < 200);
+        REQUIRE(model.GetPointMultiplicities().size() == model.GetUniquePointCount());
+        size_t multiplicity_sum = 0;
+        for (size_t multiplicity : model.GetPointMultiplicities()) {
+            multiplicity_sum += multiplicity;
+        }
+        REQUIRE(multiplicity_sum == 200);
+        size_t last_unique_index = model.GetPointUniqueIndices()[199];
+        REQUIRE(model.GetPositiveZScoreProbabilities()[last_unique_index] == 1);
+        REQUIRE(model.GetNegativeZScoreProbabilities()[last_unique_index] == 1);
+    }
+
+    SECTION("Centroid counts every volatility point") {
+        model.AssignClusterPoints(1);
+        model.UpdateCentroidData();
+        REQUIRE(model.GetCentroids()[0].point_count == 200);
+    }
+}
+
+TEST_CASE("Trained volatility model") {
+    finadvisor::VolatilityModel model{};
+    std::stringstream model_file(GenerateVolatilityFile(100));
+    model_file >> model;
+    // Volatility points accumulate across lines, so those of each type converge to a point set by their line length
+    double high_implied_probability = 2;
+    double low_historical_probability = 10.0 / 9;
+
+    SECTION("Untrained model cannot classify") {
+        REQUIRE_FALSE(model.IsTrained());
+        REQUIRE_THROWS_AS(model.ClassifyVolatilityPoint(0, high_implied_probability), std::invalid_argument);
+    }
+
+    SECTION("Empty model cannot be trained") {
+        finadvisor::VolatilityModel empty_model{};
+        REQUIRE_THROWS_AS(empty_model.Train(5), std::invalid_argument);
+        REQUIRE_THROWS_AS(model.Train(0), std::invalid_argument);
+    }
+
+    model.Train(50);
+
+    SECTION("Points take volatility type of nearest cluster") {
+        REQUIRE(model.IsTrained());
+        REQUIRE(model.GetClusterCount() == 50);
+        REQUIRE(finadvisor::FormatVolatilityType(model.ClassifyVolatilityPoint(0, high_implied_probability)) ==
+                "High Implied");
+        REQUIRE(finadvisor::FormatVolatilityType(model.ClassifyVolatilityPoint(0, low_historical_probability)) ==
+                "Low Historical");
+    }
+
+    SECTION("Clusters are frozen between classifications") {
+        size_t cluster_count = model.GetClusterCount();
+        model.ClassifyVolatilityPoint(0.5, 0.5);
+        REQUIRE(model.GetClusterCount() == cluster_count);
+    }
+
+    SECTION("Training cost is reported") {
+        model.SetClusteringMethod(finadvisor::ClusteringMethod::Lloyd);
+        model.Train(50);
+        REQUIRE(model.GetCentroids().size() == model.GetClusterCount());
+        REQUIRE(model.GetIterationCount() > 0);
+        REQUIRE(model.GetInertia() >= 0);
+    }
+
+    SECTION("Validation accuracy does not depend on thread count") {
+        std::stringstream testing_file;
+        testing_file << "High Implied\n";
+        for (size_t point = 0; point < 300; point++) {
+            testing_file << "0 " << high_implied_probability << "\n";
+        }
+        testing_file << "Low Historical\n";
+        for (size_t point = 0; point < 300; point++) {
+            testing_file << "0 " << low_historical_probability << "\n";
+        }
+        finadvisor::VolatilityClassifier classifier;
+        testing_file >> classifier;
+
+        classifier.SetThreadCount(1);
+        REQUIRE(classifier.CalculateValidationAccuracy(model) == 1);
+        classifier.SetThreadCount(4);
+        REQUIRE(classifier.CalculateValidationAccuracy(model) == 1);
+    }
+}
+
+TEST_CASE("Lloyd k-means engine") {
+    // Two groups of weighted volatility points around (0.2, 0.8) and (0.7, 0.3)
+    std::vector<double> x_coordinates = {0.1, 0.2, 0.3, 0.6, 0.7, 0.8};
+    std::vector<double> y_coordinates = {0.9, 0.8, 0.7, 0.4, 0.3, 0.2};
+    std::vector<size_t> weights = {1, 2, 1, 3, 1, 1};
+    finadvisor::VolatilityPointArrays points = {x_coordinates.data(), y_coordinates.data(), weights.data(), 6};
+    std::vector<finadvisor::VolatilityPoint> clusters = {{finadvisor::kNoLabel_, 0.1, 0.9},
+                                                         {finadvisor::kNoLabel_, 0.3, 0.7}};
+    std::vector<finadvisor::Centroid> centroids;
+    std::vector<size_t> point_clusters;
+    std::vector<double> minimum_distances;
+
+    SECTION("Converges to the mean of each group") {
+        finadvisor::ClusteringReport report = finadvisor::RunLloydKMeans(points, 100, 1, clusters, centroids,
+                                                                         point_clusters, minimum_distances);
+        REQUIRE(report.converged);
+        REQUIRE(report.iteration_count > 1);
+        REQUIRE(centroids.size() == 2);
+        REQUIRE(point_clusters == std::vector<size_t>{0, 0, 0, 1, 1, 1});
+        REQUIRE(centroids[0].point_count == 4);
+        REQUIRE(centroids[1].point_count == 5);
+        REQUIRE(Approx(clusters[0].positive_z_score_probability) == 0.2);
+        REQUIRE(Approx(clusters[1].positive_z_score_probability) == 3.3 / 5);
+        // Weighted squared distances to (0.2, 0.8) and (0.66, 0.34)
+        REQUIRE(Approx(report.inertia) == (0.02 + 0.02) + (3 * 0.0072 + 0.0032 + 0.0392));
+    }
+
+    SECTION("Iteration cap stops the run") {
+        finadvisor::ClusteringReport report = finadvisor::RunLloydKMeans(points, 1, 1, clusters, centroids,
+                                                                         point_clusters, minimum_distances);
+        REQUIRE_FALSE(report.converged);
+        REQUIRE(report.iteration_count == 1);
+        REQUIRE(centroids[0].point_count + centroids[1].point_count == 9);
+        // Clusters still end at the mean of their points, and inertia is measured against those positions
+        for (size_t cluster_id = 0; cluster_id < 2; cluster_id++) {
+            REQUIRE(clusters[cluster_id].positive_z_score_probability ==
+                    centroids[cluster_id].x_coordinate_sum / centroids[cluster_id].point_count);
+            REQUIRE(clusters[cluster_id].negative_z_score_probability ==
+                    centroids[cluster_id].y_coordinate_sum / centroids[cluster_id].point_count);
+        }
+        for (size_t point = 0; point < 6; point++) {
+            const finadvisor::VolatilityPoint& cluster = clusters[point_clusters[point]];
+            double x_difference = x_coordinates[point] - cluster.positive_z_score_probability;
+            double y_difference = y_coordinates[point] - cluster.negative_z_score_probability;
+            REQUIRE(Approx(minimum_distances[point]) == x_difference * x_difference + y_difference * y_difference);
+        }
+        REQUIRE(report.inertia == finadvisor::ComputeInertia(points, minimum_distances));
+    }
+
+    SECTION("Clusters without points keep their position") {
+        clusters.push_back({finadvisor::kNoLabel_, 5, 5});
+        finadvisor::RunLloydKMeans(points, 100, 1, clusters, centroids, point_clusters, minimum_distances);
+        REQUIRE(centroids.size() == 3);
+        REQUIRE(centroids[2].point_count == 0);
+        REQUIRE(clusters[2].positive_z_score_probability == 5);
+    }
+}
+
+TEST_CASE("Lloyd k-means does not depend on thread count") {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    std::uniform_int_distribution<size_t> weight(1, 4);
+    // Several chunks of volatility points, so assignment and centroid sums are split across tasks
+    size_t point_count = 20000;
+    std::vector<double> x_coordinates(point_count);
+    std::vector<double> y_coordinates(point_count);
+    std::vector<size_t> weights(point_count);
+    for (size_t point = 0; point < point_count; point++) {
+        x_coordinates[point] = coordinate(generator);
+        y_coordinates[point] = coordinate(generator);
+        weights[point] = weight(generator);
+    }
+    finadvisor::VolatilityPointArrays points = {x_coordinates.data(), y_coordinates.data(), weights.data(),
+                                                point_count};
+
+    std::vector<finadvisor::VolatilityPoint> seeds;
+    for (size_t cluster_id = 0; cluster_id < 8; cluster_id++) {
+        seeds.push_back({finadvisor::kNoLabel_, x_coordinates[cluster_id], y_coordinates[cluster_id]});
+    }
+    std::vector<finadvisor::VolatilityPoint> serial_clusters = seeds;
+    std::vector<finadvisor::VolatilityPoint> parallel_clusters = seeds;
+    std::vector<finadvisor::Centroid> serial_centroids;
+    std::vector<finadvisor::Centroid> parallel_centroids;
+    std::vector<size_t> serial_point_clusters;
+    std::vector<size_t> parallel_point_clusters;
+    std::vector<double> minimum_distances;
+    finadvisor::ClusteringReport serial_report = finadvisor::RunLloydKMeans(
+            points, 50, 1, serial_clusters, serial_centroids, serial_point_clusters, minimum_distances);
+    finadvisor::ClusteringReport parallel_report = finadvisor::RunLloydKMeans(
+            points, 50, 4, parallel_clusters, parallel_centroids, parallel_point_clusters, minimum_distances);
+
+    REQUIRE(serial_report.iteration_count == parallel_report.iteration_count);
+    REQUIRE(serial_report.inertia == parallel_report.inertia);
+    REQUIRE(serial_point_clusters == parallel_point_clusters);
+    for (size_t cluster_id = 0; cluster_id < seeds.size(); cluster_id++) {
+        REQUIRE(serial_clusters[cluster_id].positive_z_score_probability ==
+                parallel_clusters[cluster_id].positive_z_score_probability);
+        REQUIRE(serial_clusters[cluster_id].negative_z_score_probability ==
+                parallel_clusters[cluster_id].negative_z_score_probability);
+    }
+}
+
+TEST_CASE("k-means++ seeding") {
+    std::vector<double> x_coordinates = {0.1, 0.1, 0.5, 0.9, 0.9};
+    std::vector<double> y_coordinates = {0.9, 0.9, 0.5, 0.1, 0.1};
+    std::vector<size_t> weights = {1, 3, 2, 4, 1};
+    finadvisor::VolatilityPointArrays points = {x_coordinates.data(), y_coordinates.data(), weights.data(), 5};
+    std::vector<finadvisor::VolatilityPoint> clusters;
+    std::vector<double> minimum_distances;
+
+    SECTION("Clusters never share a position") {
+        std::mt19937_64 generator(11);
+        for (size_t run = 0; run < 20; run++) {
+            finadvisor::SeedKMeansPlusPlus(points, 5, generator, clusters, minimum_distances);
+            // Only three volatility points are distinct
+            REQUIRE(clusters.size() == 3);
+            for (double minimum_distance : minimum_distances) {
+                REQUIRE(minimum_distance == 0);
+            }
+        }
+    }
+
+    SECTION("Same seed draws same clusters") {
+        std::mt19937_64 first_generator(3);
+        std::mt19937_64 second_generator(3);
+        std::vector<finadvisor::VolatilityPoint> second_clusters;
+        finadvisor::SeedKMeansPlusPlus(points, 2, first_generator, clusters, minimum_distances);
+        finadvisor::SeedKMeansPlusPlus(points, 2, second_generator, second_clusters, minimum_distances);
+        REQUIRE(clusters.size() == 2);
+        for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+            REQUIRE(clusters[cluster_id].positive_z_score_probability ==
+                    second_clusters[cluster_id].positive_z_score_probability);
+            REQUIRE(clusters[cluster_id].negative_z_score_probability ==
+                    second_clusters[cluster_id].negative_z_score_probability);
+        }
+    }
+}
+
+TEST_CASE("Volatility models train reproducibly") {
+    std::string volatility_file = GenerateVolatilityFile(100);
+    finadvisor::VolatilityModel models[3];
+    for (finadvisor::VolatilityModel& model : models) {
+        std::stringstream model_file(volatility_file);
+        model_file >> model;
+        model.SetClusteringMethod(finadvisor::ClusteringMethod::Lloyd);
+        model.SetRandomSeed(17);
+        model.SetThreadCount(1);
+    }
+
+    // Models owning their generators train concurrently without sharing random state
+    std::thread first_thread([&]() { models[0].Train(4); });
+    std::thread second_thread([&]() { models[1].Train(4); });
+    first_thread.join();
+    second_thread.join();
+    models[2].Train(4);
+
+    for (size_t model = 1; model < 3; model++) {
+        REQUIRE(models[model].GetClusterCount() == models[0].GetClusterCount());
+        REQUIRE(models[model].GetIterationCount() == models[0].GetIterationCount());
+        REQUIRE(models[model].GetInertia() == models[0].GetInertia());
+        for (size_t cluster_id = 0; cluster_id < models[0].GetClusterCount(); cluster_id++) {
+            REQUIRE(models[model].GetClusters()[cluster_id].negative_z_score_probability ==
+                    models[0].GetClusters()[cluster_id].negative_z_score_probability);
+        }
+    }
+}
+
+TEST_CASE("Hamerly k-means matches Lloyd k-means") {
+    std::mt19937 generator(23);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    size_t point_count = 20000;
+    std::vector<double> x_coordinates(point_count);
+    std::vector<double> y_coordinates(point_count);
+    std::vector<size_t> weights(point_count, 1);
+    for (size_t point = 0; point < point_count; point++) {
+        x_coordinates[point] = coordinate(generator);
+        y_coordinates[point] = coordinate(generator);
+    }
+
+    SECTION("Random volatility points") {
+        // Coordinates are left as drawn
+    }
+
+    SECTION("Volatility points on a lattice, with many ties between clusters") {
+        for (size_t point = 0; point < point_count; point++) {
+            x_coordinates[point] = std::floor(x_coordinates[point] * 8) / 8;
+            y_coordinates[point] = std::floor(y_coordinates[point] * 8) / 8;
+        }
+    }
+
+    size_t maximum_iteration_count = 100;
+    SECTION("Iteration cap stops both runs") {
+        maximum_iteration_count = 3;
+    }
+
+    finadvisor::VolatilityPointArrays points = {x_coordinates.data(), y_coordinates.data(), weights.data(),
+                                                point_count};
+    std::mt19937_64 seed_generator(5);
+    std::vector<finadvisor::VolatilityPoint> lloyd_clusters;
+    std::vector<double> minimum_distances;
+    finadvisor::SeedKMeansPlusPlus(points, 16, seed_generator, lloyd_clusters, minimum_distances);
+    std::vector<finadvisor::VolatilityPoint> hamerly_clusters = lloyd_clusters;
+
+    std::vector<finadvisor::Centroid> lloyd_centroids;
+    std::vector<finadvisor::Centroid> hamerly_centroids;
+    std::vector<size_t> lloyd_point_clusters;
+    std::vector<size_t> hamerly_point_clusters;
+    std::vector<double> lloyd_minimum_distances;
+    std::vector<double> hamerly_minimum_distances;
+    finadvisor::ClusteringReport lloyd_report = finadvisor::RunLloydKMeans(
+            points, maximum_iteration_count, 0, lloyd_clusters, lloyd_centroids, lloyd_point_clusters,
+            lloyd_minimum_distances);
+    finadvisor::ClusteringReport hamerly_report = finadvisor::RunHamerlyKMeans(
+            points, maximum_iteration_count, 0, hamerly_clusters, hamerly_centroids, hamerly_point_clusters,
+            hamerly_minimum_distances);
+
+    REQUIRE(hamerly_report.iteration_count == lloyd_report.iteration_count);
+    REQUIRE(hamerly_report.converged == lloyd_report.converged);
+    REQUIRE(hamerly_report.inertia == lloyd_report.inertia);
+    REQUIRE(hamerly_point_clusters == lloyd_point_clusters);
+    REQUIRE(hamerly_minimum_distances == lloyd_minimum_distances);
+    for (size_t cluster_id = 0; cluster_id < lloyd_clusters.size(); cluster_id++) {
+        REQUIRE(hamerly_clusters[cluster_id].positive_z_score_probability ==
+                lloyd_clusters[cluster_id].positive_z_score_probability);
+        REQUIRE(hamerly_clusters[cluster_id].negative_z_score_probability ==
+                lloyd_clusters[cluster_id].negative_z_score_probability);
+        REQUIRE(hamerly_centroids[cluster_id].point_count == lloyd_centroids[cluster_id].point_count);
+    }
+}
+
+TEST_CASE("Clustering method of volatility model") {
+    std::string volatility_file = GenerateVolatilityFile(100);
+    finadvisor::VolatilityModel lloyd_model{};
+    finadvisor::VolatilityModel hamerly_model{};
+    std::stringstream lloyd_file(volatility_file);
+    lloyd_file >> lloyd_model;
+    std::stringstream hamerly_file(volatility_file);
+    hamerly_file >> hamerly_model;
+    lloyd_model.SetClusteringMethod(finadvisor::ClusteringMethod::Lloyd);
+    hamerly_model.SetClusteringMethod(finadvisor::ClusteringMethod::Hamerly);
+    lloyd_model.Train(6);
+    hamerly_model.Train(6);
+
+    REQUIRE(hamerly_model.GetIterationCount() == lloyd_model.GetIterationCount());
+    REQUIRE(hamerly_model.GetInertia() == lloyd_model.GetInertia());
+    for (size_t cluster_id = 0; cluster_id < lloyd_model.GetClusterCount(); cluster_id++) {
+        REQUIRE(hamerly_model.GetClusters()[cluster_id].volatility_type ==
+                lloyd_model.GetClusters()[cluster_id].volatility_type);
+        REQUIRE(hamerly_model.GetClusters()[cluster_id].negative_z_score_probability ==
+                lloyd_model.GetClusters()[cluster_id].negative_z_score_probability);
+    }
+}
+
+TEST_CASE("Optimal one dimensional clustering") {
+    // Weighted volatility points on the line y = 1 - x, given out of order
+    std::vector<double> x_coordinates = {0.9, 0.1, 0.35, 0.2, 0.8, 0.5, 0.15, 0.55};
+    std::vector<double> y_coordinates;
+    for (double x_coordinate : x_coordinates) {
+        y_coordinates.push_back(1 - x_coordinate);
+    }
+    std::vector<size_t> weights = {2, 1, 3, 1, 1, 2, 4, 1};
+    finadvisor::VolatilityPointArrays points = {x_coordinates.data(), y_coordinates.data(), weights.data(), 8};
+    std::vector<double> line_coordinates;
+    std::vector<finadvisor::VolatilityPoint> clusters;
+    std::vector<finadvisor::Centroid> centroids;
+    std::vector<size_t> point_clusters;
+    std::vector<double> minimum_distances;
+
+    SECTION("Collinear volatility points are detected") {
+        REQUIRE(finadvisor::ProjectOntoLine(points, line_coordinates));
+        y_coordinates[3] += 0.01;
+        REQUIRE_FALSE(finadvisor::ProjectOntoLine(points, line_coordinates));
+    }
+
+    SECTION("Inertia is the lowest over every split of sorted points") {
+        REQUIRE(finadvisor::ProjectOntoLine(points, line_coordinates));
+        for (size_t cluster_count = 1; cluster_count <= 4; cluster_count++) {
+            finadvisor::ClusteringReport report = finadvisor::RunOptimalOneDimensionalKMeans(
+                    points, line_coordinates, cluster_count, 1, clusters, centroids, point_clusters,
+                    minimum_distances);
+            REQUIRE(clusters.size() == cluster_count);
+
+            // Exhaustive search over ways to cut the sorted points into cluster_count runs
+            std::vector<size_t> sorted_points = {1, 6, 3, 2, 5, 7, 4, 0};
+            double minimum_inertia = DBL_MAX;
+            for (size_t cuts = 0; cuts < (1u << 7); cuts++) {
+                if (static_cast<size_t>(__builtin_popcount(cuts)) + 1 != cluster_count) {
+                    continue;
+                }
+                double inertia = 0;
+                size_t begin = 0;
+                for (size_t end = 1; end <= 8; end++) {
+                    if (end < 8 && !(cuts & (1u << (end - 1)))) {
+                        continue;
+                    }
+                    double weight_sum = 0;
+                    double x_sum = 0;
+                    for (size_t rank = begin; rank < end; rank++) {
+                        weight_sum += weights[sorted_points[rank]];
+                        x_sum += weights[sorted_points[rank]] * x_coordinates[sorted_points[rank]];
+                    }
+                    for (size_t rank = begin; rank < end; rank++) {
+                        double x_difference = x_coordinates[sorted_points[rank]] - x_sum / weight_sum;
+                        // Distance along y = 1 - x is the x difference times the square root of 2
+                        inertia += weights[sorted_points[rank]] * 2 * x_difference * x_difference;
+                    }
+                    begin = end;
+                }
+                minimum_inertia = std::min(minimum_inertia, inertia);
+            }
+            REQUIRE(Approx(report.inertia).margin(1e-12) == minimum_inertia);
+        }
+    }
+
+    SECTION("Clusters follow the line and never exceed distinct positions") {
+        REQUIRE(finadvisor::ProjectOntoLine(points, line_coordinates));
+        finadvisor::RunOptimalOneDimensionalKMeans(points, line_coordinates, 20, 1, clusters, centroids,
+                                                   point_clusters, minimum_distances);
+        REQUIRE(clusters.size() == 8);
+        for (size_t cluster_id = 1; cluster_id < clusters.size(); cluster_id++) {
+            REQUIRE(clusters[cluster_id - 1].negative_z_score_probability !=
+                    clusters[cluster_id].negative_z_score_probability);
+        }
+        // Every cluster sits on its only position, up to rounding of the weighted mean
+        for (double minimum_distance : minimum_distances) {
+            REQUIRE(minimum_distance < 1e-30);
+        }
+    }
+}
+
+TEST_CASE("One dimensional clustering of volatility model") {
+    // Volatility points read from file differ only in their negative z-score probability
+    std::string volatility_file = GenerateVolatilityFile(100);
+    finadvisor::VolatilityModel models[2];
+    for (size_t model = 0; model < 2; model++) {
+        std::stringstream model_file(volatility_file);
+        model_file >> models[model];
+        models[model].SetRandomSeed(model);
+        models[model].Train(4);
+    }
+
+    SECTION("Clustering is deterministic") {
+        REQUIRE(models[0].GetIterationCount() == 0);
+        REQUIRE(models[1].GetInertia() == models[0].GetInertia());
+        for (size_t cluster_id = 0; cluster_id < models[0].GetClusterCount(); cluster_id++) {
+            REQUIRE(models[1].GetClusters()[cluster_id].negative_z_score_probability ==
+                    models[0].GetClusters()[cluster_id].negative_z_score_probability);
+        }
+    }
+
+    SECTION("Inertia is no higher than k-means") {
+        for (uint64_t random_seed = 0; random_seed < 5; random_seed++) {
+            finadvisor::VolatilityModel lloyd_model{};
+            std::stringstream model_file(volatility_file);
+            model_file >> lloyd_model;
+            lloyd_model.SetClusteringMethod(finadvisor::ClusteringMethod::Lloyd);
+            lloyd_model.SetRandomSeed(random_seed);
+            lloyd_model.Train(4);
+            REQUIRE(models[0].GetInertia() <= lloyd_model.GetInertia() * (1 + 1e-12));
+        }
+    }
+}
+
+TEST_CASE("Mini-batch k-means") {
+    std::vector<finadvisor::VolatilityPoint> clusters = {{finadvisor::kNoLabel_, 0, 0},
+                                                         {finadvisor::kNoLabel_, 1, 1}};
+    std::vector<finadvisor::Centroid> centroids = {{2, 0, 0}, {2, 2, 2}};
+    std::vector<double> x_coordinates = {0.3, 1, 0.1, 0.9};
+    std::vector<double> y_coordinates = {0, 1.6, 0.2, 0.8};
+    std::vector<size_t> weights = {1, 1, 2, 1};
+    finadvisor::VolatilityPointArrays batch = {x_coordinates.data(), y_coordinates.data(), weights.data(), 4};
+    std::vector<size_t> batch_clusters;
+    finadvisor::FoldMiniBatch(batch, 1, clusters, centroids, batch_clusters);
+
+    SECTION("Volatility points join their nearest cluster") {
+        REQUIRE(batch_clusters == std::vector<size_t>{0, 1, 0, 1});
+        REQUIRE(centroids[0].point_count == 5);
+        REQUIRE(centroids[1].point_count == 4);
+    }
+
+    SECTION("Clusters stay at the mean of every volatility point absorbed") {
+        for (size_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+            REQUIRE(Approx(clusters[cluster_id].positive_z_score_probability) ==
+                    centroids[cluster_id].x_coordinate_sum / centroids[cluster_id].point_count);
+            REQUIRE(Approx(clusters[cluster_id].negative_z_score_probability) ==
+                    centroids[cluster_id].y_coordinate_sum / centroids[cluster_id].point_count);
+        }
+        REQUIRE(Approx(clusters[0].positive_z_score_probability) == 0.1);
+        REQUIRE(Approx(clusters[1].negative_z_score_probability) == 1.1);
+    }
+
+    SECTION("Clusters away from the mean of their centroid are moved onto it") {
+        clusters[0] = {finadvisor::kNoLabel_, 0.2, -0.1};
+        std::vector<double> x_coordinate = {0.4};
+        std::vector<double> y_coordinate = {0.1};
+        std::vector<size_t> weight = {3};
+        finadvisor::VolatilityPointArrays point = {x_coordinate.data(), y_coordinate.data(), weight.data(), 1};
+        finadvisor::FoldMiniBatch(point, 1, clusters, centroids, batch_clusters);
+        REQUIRE(batch_clusters == std::vector<size_t>{0});
+        REQUIRE(centroids[0].point_count == 8);
+        REQUIRE(clusters[0].positive_z_score_probability == centroids[0].x_coordinate_sum / 8);
+        REQUIRE(clusters[0].negative_z_score_probability == centroids[0].y_coordinate_sum / 8);
+    }
+}
+
+TEST_CASE("Online volatility model") {
+    finadvisor::VolatilityModel model{};
+    std::stringstream model_file(GenerateVolatilityFile(100));
+    model_file >> model;
+
+    SECTION("Untrained model cannot fold volatility points") {
+        REQUIRE_THROWS_AS(model.FoldVolatilityPoints({{finadvisor::kNoLabel_, 0, 1}}), std::invalid_argument);
+    }
+
+    model.Train(4);
+    size_t trained_point_count = 0;
+    for (const finadvisor::Centroid& centroid : model.GetCentroids()) {
+        trained_point_count += centroid.point_count;
+    }
+
+    SECTION("Generated volatility points are folded in batches instead of stored") {
+        size_t stored_point_count = model.GetVolatilityPointCount();
+        model.SetOnlineBatchSize(4);
+        for (size_t point = 0; point < 10; point++) {
+            model.SetFileLine("--");
+            model.GenerateVolatilityPoint();
+        }
+        REQUIRE(model.GetVolatilityPointCount() == stored_point_count);
+        REQUIRE(model.GetPendingPointCount() == 2);
+        size_t point_count = 0;
+        for (const finadvisor::Centroid& centroid : model.GetCentroids()) {
+            point_count += centroid.point_count;
+        }
+        REQUIRE(point_count == trained_point_count + 8);
+
+        model.FlushVolatilityPoints();
+        REQUIRE(model.GetPendingPointCount() == 0);
+        REQUIRE(model.GetCentroids()[0].point_count + model.GetCentroids()[1].point_count +
+                model.GetCentroids()[2].point_count + model.GetCentroids()[3].point_count ==
+                trained_point_count + 10);
+    }
+
+    SECTION("Clusters stay at the mean of their points after a run stopped by the iteration cap") {
+        finadvisor::VolatilityModel capped_model{};
+        std::stringstream capped_model_file(GenerateVolatilityFile(100));
+        capped_model_file >> capped_model;
+        capped_model.SetClusteringMethod(finadvisor::ClusteringMethod::Lloyd);
+        capped_model.SetMaximumIterationCount(1);
+        capped_model.Train(4);
+        std::vector<finadvisor::VolatilityPoint> volatility_points;
+        for (size_t point = 0; point < 50; point++) {
+            volatility_points.push_back({finadvisor::kNoLabel_, 0, 1 + point / 25.0});
+        }
+        capped_model.FoldVolatilityPoints(volatility_points);
+        for (size_t cluster_id = 0; cluster_id < capped_model.GetClusterCount(); cluster_id++) {
+            const finadvisor::Centroid& centroid = capped_model.GetCentroids()[cluster_id];
+            if (centroid.point_count != 0) {
+                REQUIRE(capped_model.GetClusters()[cluster_id].positive_z_score_probability ==
+                        centroid.x_coordinate_sum / centroid.point_count);
+                REQUIRE(capped_model.GetClusters()[cluster_id].negative_z_score_probability ==
+                        centroid.y_coordinate_sum / centroid.point_count);
+            }
+        }
+    }
+
+    SECTION("Clusters are relabeled with the volatility types they absorb") {
+        finadvisor::LabelId low_implied = finadvisor::ParseVolatilityType("Low Implied");
+        REQUIRE(model.ClassifyVolatilityPoint(0, 2) != low_implied);
+        std::vector<finadvisor::VolatilityPoint> volatility_points(500, {low_implied, 0, 2});
+        model.FoldVolatilityPoints(volatility_points);
+        REQUIRE(model.ClassifyVolatilityPoint(0, 2) == low_implied);
+        REQUIRE(model.GetClusterCount() == 4);
+    }
+}
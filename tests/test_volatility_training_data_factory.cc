@@ -34,34 +34,36 @@ TEST_CASE("Overload of Extraction Operator for Volatility Training Data Factory"
     std::vector<std::string> file_paths = {"stock_data.csv"};
     factory = factory.ValidateFiles(file_paths);
 
-    // Call to ValidateFiles invokes extraction operator
-    SECTION("Volatility of first map element") {
+    // Months are ordered chronologically, so the first month is April 2009
+    SECTION("Volatility of first month") {
         REQUIRE(factory.GetVolatility(0).measure == finadvisor::VolatilityMeasure::Low);
         REQUIRE(static_cast<int>(factory.GetVolatility(0).category) == 1);
     }
 
-    SECTION("Volatility of middle map element") {
+    SECTION("Volatility of middle month") {
         REQUIRE(static_cast<int>(factory.GetVolatility(5).measure) == 2);
         REQUIRE(factory.GetVolatility(5).category == finadvisor::VolatilityCategory::Historical);
     }
 
-    SECTION("Volatility of last map element") {
+    SECTION("Volatility of last month") {
         REQUIRE(static_cast<int>(factory.GetVolatility(10).measure) == 2);
         REQUIRE(static_cast<int>(factory.GetVolatility(10).category) == 1);
     }
 
-    SECTION("Standardized Quartile Prices of first map element") {
-        std::vector<double> standardized_quartile_prices = {0.4354, -0.4653, -0.7643, 0.6543};
-        REQUIRE(Approx(factory.GetStandardizedQuartilePrices(0)[0]) == -2.9031606032);
+    SECTION("Standardized Quartile Prices of first month") {
+        REQUIRE(Approx(factory.GetStandardizedQuartilePrices(0)[0]) == -1.7192861389);
     }
 
-    SECTION("Standardized Quartile Prices of middle map element") {
-        std::vector<double> standardized_quartile_prices = {-0.5643, 0.7684, 0.9465, 0.9574, -0.43234, 0.4824, 0.4328};
-        REQUIRE(Approx(factory.GetStandardizedQuartilePrices(5)[3]) == -1.0038978863);
+    SECTION("Standardized Quartile Prices of middle month") {
+        REQUIRE(Approx(factory.GetStandardizedQuartilePrices(5)[3]) == -1.6947663198);
     }
 
-    SECTION("Standardized Quartile Prices of last map element") {
-        std::vector<double> standardized_quartile_prices = {0.9432, -0.3545, 0.4545};
-        REQUIRE(Approx(factory.GetStandardizedQuartilePrices(10)[2]) == -1.8675681209);
+    SECTION("Standardized Quartile Prices of last month") {
+        REQUIRE(Approx(factory.GetStandardizedQuartilePrices(10)[2]) == 1.8004721388);
+    }
+
+    SECTION("Find month by year and month") {
+        REQUIRE(factory.FindMonth(0, 2009, 4) == 0);
+        REQUIRE(factory.GetVolatility(factory.FindMonth(0, 2010, 2)).measure == factory.GetVolatility(10).measure);
     }
 }